@@ -0,0 +1,214 @@
+#include "BuddyAllocator.h"
+#include <iostream>
+#include <iomanip>
+
+BuddyAllocator::BuddyAllocator(int baseFrame, int frameCount)
+    : baseFrame(baseFrame), frameCount(frameCount), maxOrder(0), freeCount(0) {
+    while ((1 << (maxOrder + 1)) <= frameCount) {
+        maxOrder++;
+    }
+
+    freeHead.assign(maxOrder + 1, -1);
+    nextFree.assign(frameCount, -1);
+    prevFree.assign(frameCount, -1);
+    blockOrder.assign(frameCount, -1);
+    freeBitmap.assign((frameCount + 63) / 64, 0);
+
+    // 页框数不是 2 的幂时，按地址顺序切成若干个对齐的最大块
+    int index = 0;
+    while (index < frameCount) {
+        int order = maxOrder;
+        while (order > 0 && ((index & ((1 << order) - 1)) != 0 || index + (1 << order) > frameCount)) {
+            order--;
+        }
+        pushBlock(index, order);
+        markRange(index, 1 << order, true);
+        freeCount += 1 << order;
+        index += 1 << order;
+    }
+}
+
+void BuddyAllocator::pushBlock(int index, int order) {
+    blockOrder[index] = (signed char)order;
+    prevFree[index] = -1;
+    nextFree[index] = freeHead[order];
+    if (freeHead[order] != -1) {
+        prevFree[freeHead[order]] = index;
+    }
+    freeHead[order] = index;
+}
+
+void BuddyAllocator::removeBlock(int index, int order) {
+    if (prevFree[index] != -1) {
+        nextFree[prevFree[index]] = nextFree[index];
+    } else {
+        freeHead[order] = nextFree[index];
+    }
+    if (nextFree[index] != -1) {
+        prevFree[nextFree[index]] = prevFree[index];
+    }
+    blockOrder[index] = -1;
+    nextFree[index] = prevFree[index] = -1;
+}
+
+void BuddyAllocator::markRange(int index, int count, bool isFree) {
+    for (int i = index; i < index + count; i++) {
+        if (isFree) {
+            freeBitmap[i >> 6] |= 1ULL << (i & 63);
+        } else {
+            freeBitmap[i >> 6] &= ~(1ULL << (i & 63));
+        }
+    }
+}
+
+int BuddyAllocator::allocate(int order) {
+    if (order < 0 || order > maxOrder) return -1;
+
+    // 找到不小于所需阶的最小空闲块
+    int current = order;
+    while (current <= maxOrder && freeHead[current] == -1) {
+        current++;
+    }
+    if (current > maxOrder) return -1;
+
+    int index = freeHead[current];
+    removeBlock(index, current);
+
+    // 逐级拆分，后半块作为伙伴放回低一阶的空闲链表
+    while (current > order) {
+        current--;
+        pushBlock(index + (1 << current), current);
+    }
+
+    markRange(index, 1 << order, false);
+    freeCount -= 1 << order;
+    return baseFrame + index;
+}
+
+void BuddyAllocator::free(int frame, int order) {
+    int index = frame - baseFrame;
+    if (index < 0 || index >= frameCount || order < 0 || order > maxOrder) return;
+
+    markRange(index, 1 << order, true);
+    freeCount += 1 << order;
+
+    // 伙伴同样空闲且同阶时合并，直到无法合并
+    while (order < maxOrder) {
+        int buddy = index ^ (1 << order);
+        if (buddy >= frameCount || blockOrder[buddy] != order) break;
+        removeBlock(buddy, order);
+        index &= ~(1 << order);
+        order++;
+    }
+    pushBlock(index, order);
+}
+
+bool BuddyAllocator::claim(int frame) {
+    if (!isFree(frame)) return false;
+
+    // 找到包含该页框的空闲块
+    int index = frame - baseFrame;
+    int order = 0;
+    int head = index;
+    while (order <= maxOrder) {
+        head = index & ~((1 << order) - 1);
+        if (blockOrder[head] == order) break;
+        order++;
+    }
+    if (order > maxOrder) return false;
+    removeBlock(head, order);
+
+    // 逐级拆分，不含该页框的一半放回低一阶的空闲链表
+    while (order > 0) {
+        order--;
+        int half = head + (1 << order);
+        if (index >= half) {
+            pushBlock(head, order);
+            head = half;
+        } else {
+            pushBlock(half, order);
+        }
+    }
+
+    markRange(index, 1, false);
+    freeCount--;
+    return true;
+}
+
+bool BuddyAllocator::allocateBatch(int count, std::vector<int>& frames) {
+    if (count > freeCount) return false;
+
+    // 按 count 的二进制分解从大到小取块，取不到则降阶
+    size_t start = frames.size();
+    int remaining = count;
+    int order = maxOrder;
+    while (remaining > 0) {
+        while (order > 0 && (1 << order) > remaining) order--;
+        int frame = allocate(order);
+        if (frame == -1) {
+            if (order == 0) break;
+            order--;
+            continue;
+        }
+        for (int i = 0; i < (1 << order); i++) {
+            frames.push_back(frame + i);
+        }
+        remaining -= 1 << order;
+    }
+
+    if (remaining > 0) {
+        // 回滚：逐页归还，伙伴合并会把它们拼回原来的块，不必另记各块的阶
+        for (size_t i = start; i < frames.size(); i++) {
+            free(frames[i], 0);
+        }
+        frames.resize(start);
+        return false;
+    }
+    return true;
+}
+
+bool BuddyAllocator::isFree(int frame) const {
+    int index = frame - baseFrame;
+    if (index < 0 || index >= frameCount) return false;
+    return (freeBitmap[index >> 6] >> (index & 63)) & 1ULL;
+}
+
+int BuddyAllocator::getFreeCount() const {
+    return freeCount;
+}
+
+int BuddyAllocator::getMaxOrder() const {
+    return maxOrder;
+}
+
+int BuddyAllocator::getLargestFreeOrder() const {
+    for (int order = maxOrder; order >= 0; order--) {
+        if (freeHead[order] != -1) return order;
+    }
+    return -1;
+}
+
+int BuddyAllocator::getFreeBlockCount(int order) const {
+    if (order < 0 || order > maxOrder) return 0;
+    int count = 0;
+    for (int index = freeHead[order]; index != -1; index = nextFree[index]) {
+        count++;
+    }
+    return count;
+}
+
+double BuddyAllocator::getFragmentation() const {
+    if (freeCount == 0) return 0.0;
+    int largest = getLargestFreeOrder();
+    return 1.0 - (double)(1 << largest) / freeCount;
+}
+
+void BuddyAllocator::showStatus() const {
+    std::cout << "伙伴系统空闲块: ";
+    for (int order = 0; order <= maxOrder; order++) {
+        std::cout << "[" << order << "阶:" << getFreeBlockCount(order) << "] ";
+    }
+    std::cout << std::endl;
+    std::cout << "外部碎片率: " << std::fixed << std::setprecision(2)
+              << getFragmentation() * 100 << "%" << std::endl;
+}
@@ -0,0 +1,58 @@
+#ifndef BUDDYALLOCATOR_H
+#define BUDDYALLOCATOR_H
+
+#include <vector>
+#include <cstdint>
+
+// 伙伴系统页框分配器
+// 空闲块按阶（2^order 个连续页框）挂在各阶空闲链表上，分配时自上而下拆分，释放时与伙伴合并。
+// 另用位图记录每个页框的空闲状态，便于统计碎片和检查连续性。
+class BuddyAllocator {
+private:
+    int baseFrame;   // 管理区间的起始页框号
+    int frameCount;  // 管理的页框数
+    int maxOrder;    // 最大阶
+    int freeCount;   // 空闲页框数
+
+    std::vector<int> freeHead;          // 各阶空闲链表表头
+    std::vector<int> nextFree;          // 空闲块双向链表（以块首页框为下标）
+    std::vector<int> prevFree;
+    std::vector<signed char> blockOrder; // 空闲块首页框的阶，非块首为 -1
+    std::vector<uint64_t> freeBitmap;    // 页框空闲位图
+
+    void pushBlock(int index, int order);
+    void removeBlock(int index, int order);
+    void markRange(int index, int count, bool isFree);
+
+public:
+    BuddyAllocator(int baseFrame, int frameCount);
+
+    // 分配 2^order 个物理连续的页框，返回起始页框号，失败返回 -1
+    int allocate(int order);
+
+    // 释放从 frame 开始的 2^order 个页框，并与空闲伙伴逐级合并
+    void free(int frame, int order);
+
+    // 分配指定的空闲页框（内存规整的迁移目标），页框不空闲返回 false
+    bool claim(int frame);
+
+    // 一次调用分配 count 个页框（尽量使用大块），全部成功返回 true，否则不分配任何页框
+    bool allocateBatch(int count, std::vector<int>& frames);
+
+    bool isFree(int frame) const;
+    int getFreeCount() const;
+    int getMaxOrder() const;
+
+    // 当前能满足的最大阶，无空闲页框返回 -1
+    int getLargestFreeOrder() const;
+
+    // 某一阶的空闲块数
+    int getFreeBlockCount(int order) const;
+
+    // 外部碎片率：1 - 最大空闲块 / 空闲页框总数
+    double getFragmentation() const;
+
+    void showStatus() const;
+};
+
+#endif // BUDDYALLOCATOR_H
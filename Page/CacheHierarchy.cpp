@@ -0,0 +1,278 @@
+#include "CacheHierarchy.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+std::vector<CacheLevelConfig> CacheHierarchy::defaultConfig() {
+    return {
+        {"L1", 32, 8, 64, 4, CACHE_LRU},
+        {"L2", 256, 8, 64, 12, CACHE_LRU},
+        {"LLC", 2048, 16, 64, 40, CACHE_LRU},
+    };
+}
+
+bool CacheHierarchy::isValidConfig(const std::vector<CacheLevelConfig>& configs) {
+    if (configs.empty()) {
+        return false;
+    }
+    for (const CacheLevelConfig& config : configs) {
+        int lineBytes = config.lineBytes;
+        if (lineBytes <= 0 || (lineBytes & (lineBytes - 1)) != 0 || lineBytes != configs[0].lineBytes) {
+            return false;
+        }
+        if (config.associativity <= 0 || config.hitCycles < 0 ||
+            (long long)config.sizeKB * 1024 < (long long)config.associativity * lineBytes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CacheHierarchy::CacheHierarchy(const std::vector<CacheLevelConfig>& configs, int memoryCycles)
+    : memoryCycles(memoryCycles), clock(0), randomState(0x9E3779B97F4A7C15ULL), lastProcess(-1),
+      contextSwitches(0) {
+    for (const CacheLevelConfig& config : configs) {
+        Level level;
+        level.config = config;
+        level.sets = (int)((long long)config.sizeKB * 1024 / ((long long)config.associativity * config.lineBytes));
+        level.lines.assign((size_t)level.sets * config.associativity, Line{-1, -1, 0});
+        level.ghosts = level.lines;
+        level.hits = 0;
+        level.misses = 0;
+        level.crossEvictions = 0;
+        levels.push_back(level);
+    }
+}
+
+bool CacheHierarchy::lookup(Level& level, long long address) {
+    Line* set = &level.lines[(size_t)(address % level.sets) * level.config.associativity];
+    for (int way = 0; way < level.config.associativity; way++) {
+        if (set[way].address == address) {
+            if (level.config.replacement == CACHE_LRU) {
+                set[way].stamp = clock;
+            }
+            level.hits++;
+            return true;
+        }
+    }
+    level.misses++;
+    return false;
+}
+
+bool CacheHierarchy::fill(Level& level, long long address, int processId) {
+    size_t base = (size_t)(address % level.sets) * level.config.associativity;
+    Line* set = &level.lines[base];
+    Line* ghosts = &level.ghosts[base];
+    int victim = -1;
+    for (int way = 0; way < level.config.associativity && victim == -1; way++) {
+        if (set[way].address == -1) {
+            victim = way;
+        }
+    }
+    if (victim == -1) {
+        if (level.config.replacement == CACHE_RANDOM) {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 7;
+            randomState ^= randomState << 17;
+            victim = (int)(randomState % level.config.associativity);
+        } else {
+            // LRU 与 FIFO 都淘汰时间戳最小的行，区别只在命中时是否刷新时间戳
+            victim = 0;
+            for (int way = 1; way < level.config.associativity; way++) {
+                if (set[way].stamp < set[victim].stamp) {
+                    victim = way;
+                }
+            }
+        }
+
+        Line& evicted = set[victim];
+        if (evicted.owner != processId) {
+            level.crossEvictions++;
+            statsOf(evicted.owner).linesLost++;
+            // 记入本组的影子行，优先用空位，否则覆盖最早的一个
+            int slot = 0;
+            for (int way = 0; way < level.config.associativity; way++) {
+                if (ghosts[way].address == -1) {
+                    slot = way;
+                    break;
+                }
+                if (ghosts[way].stamp < ghosts[slot].stamp) {
+                    slot = way;
+                }
+            }
+            ghosts[slot] = Line{evicted.address, evicted.owner, clock};
+        }
+    }
+
+    bool refill = false;
+    for (int way = 0; way < level.config.associativity; way++) {
+        if (ghosts[way].address == address) {
+            refill = ghosts[way].owner == processId;
+            ghosts[way] = Line{-1, -1, 0};
+            break;
+        }
+    }
+    set[victim] = Line{address, processId, clock};
+    return refill;
+}
+
+CacheHierarchy::ProcessStats& CacheHierarchy::statsOf(int processId) {
+    auto it = processStats.find(processId);
+    if (it == processStats.end()) {
+        ProcessStats stats = {};
+        stats.levelHits.assign(levels.size(), 0);
+        it = processStats.emplace(processId, stats).first;
+    }
+    return it->second;
+}
+
+int CacheHierarchy::access(int processId, long long physicalAddress) {
+    ProcessStats& stats = statsOf(processId);
+    if (processId != lastProcess) {
+        if (lastProcess != -1) {
+            contextSwitches++;
+            stats.switchesIn++;
+        }
+        lastProcess = processId;
+    }
+    clock++;
+    stats.accesses++;
+
+    long long address = physicalAddress / levels[0].config.lineBytes;
+    int cycles = 0;
+    int hitLevel = (int)levels.size();
+    for (int i = 0; i < (int)levels.size(); i++) {
+        cycles += levels[i].config.hitCycles;
+        if (lookup(levels[i], address)) {
+            hitLevel = i;
+            break;
+        }
+    }
+    if (hitLevel == (int)levels.size()) {
+        cycles += memoryCycles;
+        stats.memoryAccesses++;
+    } else {
+        stats.levelHits[hitLevel]++;
+    }
+
+    // 未命中的各级填入该行；若某级的行是被其他进程挤出的，没被挤出时本可在该级命中
+    int refillLevel = -1;
+    for (int i = 0; i < hitLevel; i++) {
+        if (fill(levels[i], address, processId) && refillLevel == -1) {
+            refillLevel = i;
+        }
+    }
+    if (refillLevel != -1) {
+        int wouldBe = 0;
+        for (int i = 0; i <= refillLevel; i++) {
+            wouldBe += levels[i].config.hitCycles;
+        }
+        stats.refillMisses++;
+        stats.pollutionCycles += cycles - wouldBe;
+    }
+    stats.cycles += cycles;
+    return cycles;
+}
+
+long long CacheHierarchy::accessRange(int processId, long long physicalAddress, long long length) {
+    long long lineBytes = levels[0].config.lineBytes;
+    long long cycles = 0;
+    for (long long line = physicalAddress / lineBytes; line * lineBytes < physicalAddress + length; line++) {
+        cycles += access(processId, line * lineBytes);
+    }
+    return cycles;
+}
+
+void CacheHierarchy::flush() {
+    for (Level& level : levels) {
+        std::fill(level.lines.begin(), level.lines.end(), Line{-1, -1, 0});
+        std::fill(level.ghosts.begin(), level.ghosts.end(), Line{-1, -1, 0});
+    }
+    lastProcess = -1;
+}
+
+void CacheHierarchy::resetStats() {
+    for (Level& level : levels) {
+        level.hits = 0;
+        level.misses = 0;
+        level.crossEvictions = 0;
+    }
+    contextSwitches = 0;
+    processStats.clear();
+}
+
+long long CacheHierarchy::getContextSwitches() const {
+    return contextSwitches;
+}
+
+long long CacheHierarchy::getCycles(int processId) const {
+    auto it = processStats.find(processId);
+    return it == processStats.end() ? 0 : it->second.cycles;
+}
+
+long long CacheHierarchy::getAccesses(int processId) const {
+    auto it = processStats.find(processId);
+    return it == processStats.end() ? 0 : it->second.accesses;
+}
+
+double CacheHierarchy::getHitRate(int level) const {
+    if (level < 0 || level >= (int)levels.size()) {
+        return 0.0;
+    }
+    long long total = levels[level].hits + levels[level].misses;
+    return total ? (double)levels[level].hits / total : 0.0;
+}
+
+double CacheHierarchy::getProcessHitRate(int processId, int level) const {
+    auto it = processStats.find(processId);
+    if (it == processStats.end() || level < 0 || level >= (int)levels.size()) {
+        return 0.0;
+    }
+    // 到达该级的访问 = 总访问 - 在更近各级命中的
+    long long reached = it->second.accesses;
+    for (int i = 0; i < level; i++) {
+        reached -= it->second.levelHits[i];
+    }
+    return reached ? (double)it->second.levelHits[level] / reached : 0.0;
+}
+
+void CacheHierarchy::showStatus() const {
+    static const char* const replacementNames[] = {"LRU", "FIFO", "随机"};
+    std::cout << "缓存层次:";
+    for (const Level& level : levels) {
+        std::cout << " " << level.config.name << " " << level.config.sizeKB << "KB/"
+                  << level.config.associativity << "路/" << replacementNames[level.config.replacement]
+                  << "/" << level.config.hitCycles << "周期";
+    }
+    std::cout << ", 行 " << levels[0].config.lineBytes << "B, 内存 " << memoryCycles << "周期" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (int i = 0; i < (int)levels.size(); i++) {
+        std::cout << levels[i].config.name << ": 命中率 " << getHitRate(i) * 100 << "% ("
+                  << levels[i].hits << "/" << levels[i].hits + levels[i].misses << "), 跨进程挤出 "
+                  << levels[i].crossEvictions << " 行" << std::endl;
+    }
+    std::cout << "上下文切换 " << contextSwitches << " 次" << std::endl;
+
+    std::vector<int> processIds;
+    for (const auto& entry : processStats) {
+        processIds.push_back(entry.first);
+    }
+    std::sort(processIds.begin(), processIds.end());
+
+    std::cout << "进程\t访问";
+    for (const Level& level : levels) {
+        std::cout << "\t" << level.config.name << "命中";
+    }
+    std::cout << "\t平均周期\t被挤出\t回填未命中\t污染周期\t切入" << std::endl;
+    for (int processId : processIds) {
+        const ProcessStats& stats = processStats.at(processId);
+        std::cout << processId << "\t" << stats.accesses;
+        for (int i = 0; i < (int)levels.size(); i++) {
+            std::cout << "\t" << getProcessHitRate(processId, i) * 100 << "%";
+        }
+        std::cout << "\t" << (stats.accesses ? (double)stats.cycles / stats.accesses : 0.0) << "\t\t"
+                  << stats.linesLost << "\t" << stats.refillMisses << "\t\t" << stats.pollutionCycles
+                  << "\t\t" << stats.switchesIn << std::endl;
+    }
+}
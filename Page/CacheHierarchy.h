@@ -0,0 +1,101 @@
+#ifndef CACHEHIERARCHY_H
+#define CACHEHIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+// 缓存行替换算法
+enum CacheReplacement {
+    CACHE_LRU = 0,     // 最近最少使用
+    CACHE_FIFO = 1,    // 先进先出
+    CACHE_RANDOM = 2   // 随机
+};
+
+// 一级缓存的配置：容量、组相联路数、行大小、命中延迟（周期）与替换算法
+struct CacheLevelConfig {
+    std::string name;
+    int sizeKB;
+    int associativity;
+    int lineBytes;
+    int hitCycles;
+    CacheReplacement replacement;
+};
+
+// 多级 CPU 缓存模型（如 L1/L2/LLC）：按物理地址访问，非包含式，未命中的各级都填入该行
+// 每个缓存行记录填入它的进程，被其他进程的访问挤出时计为跨进程污染；
+// 原主人再次访问被挤出的行产生的未命中称为回填未命中，其额外周期即上下文切换带来的缓存冷却代价
+class CacheHierarchy {
+private:
+    struct Line {
+        long long address;  // 行地址（物理地址 / 行大小），-1 表示无效
+        int owner;          // 填入该行的进程
+        long long stamp;    // LRU 为最近访问时刻，FIFO 为填入时刻
+    };
+
+    struct Level {
+        CacheLevelConfig config;
+        int sets;
+        std::vector<Line> lines;                  // sets * associativity 个，组内连续存放
+        std::vector<Line> ghosts;                 // 被其他进程挤出的行（地址与原主人），布局同 lines；
+                                                  // 每组只记最近的 associativity 个，空间不超过本级容量
+        long long hits;
+        long long misses;
+        long long crossEvictions;                 // 挤出其他进程的行的次数
+    };
+
+    struct ProcessStats {
+        long long accesses;
+        std::vector<long long> levelHits;   // 在各级命中的次数
+        long long memoryAccesses;           // 各级都未命中、访问内存的次数
+        long long cycles;
+        long long linesLost;                // 被其他进程挤出的行数
+        long long refillMisses;             // 回填未命中次数（按最靠近 CPU 的一级计）
+        long long pollutionCycles;          // 回填未命中多花的周期
+        long long switchesIn;               // 切换到该进程的次数
+    };
+
+    std::vector<Level> levels;
+    int memoryCycles;                       // 内存访问延迟（周期）
+    long long clock;
+    uint64_t randomState;
+    int lastProcess;                        // 上一次访问的进程，用于识别上下文切换
+    long long contextSwitches;
+    std::unordered_map<int, ProcessStats> processStats;
+
+    bool lookup(Level& level, long long address);
+    // 填入一行，返回该行此前是否被其他进程从本级挤出（且原主人正是 processId）
+    bool fill(Level& level, long long address, int processId);
+    ProcessStats& statsOf(int processId);
+
+public:
+    // 默认配置：L1 32KB 8 路 4 周期，L2 256KB 8 路 12 周期，LLC 2MB 16 路 40 周期，行 64 字节
+    static std::vector<CacheLevelConfig> defaultConfig();
+
+    // 检查配置：行大小为 2 的幂，容量至少容纳一组，且各级行大小相同
+    static bool isValidConfig(const std::vector<CacheLevelConfig>& configs);
+
+    CacheHierarchy(const std::vector<CacheLevelConfig>& configs, int memoryCycles);
+
+    // 进程访问一个物理地址，返回模拟的访问周期
+    int access(int processId, long long physicalAddress);
+
+    // 访问 [physicalAddress, physicalAddress + length) 覆盖的每一行，返回总周期
+    long long accessRange(int processId, long long physicalAddress, long long length);
+
+    // 清空所有缓存行（不清统计）
+    void flush();
+    void resetStats();
+
+    long long getContextSwitches() const;
+    long long getCycles(int processId) const;
+    long long getAccesses(int processId) const;
+    // 某级的局部命中率（到达该级的访问中命中的比例）
+    double getHitRate(int level) const;
+    double getProcessHitRate(int processId, int level) const;
+
+    void showStatus() const;
+};
+
+#endif // CACHEHIERARCHY_H
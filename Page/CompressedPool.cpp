@@ -0,0 +1,235 @@
+#include "CompressedPool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+// 压缩格式：控制字节 < 0x80 时后跟 (控制字节 + 1) 个字面字节；
+// 否则为一次匹配，长度为 (控制字节 & 0x7F) + MIN_MATCH，后跟 2 字节小端的回看距离
+static const int MIN_MATCH = 4;
+static const int MAX_MATCH = 0x7F + MIN_MATCH;
+static const int MAX_LITERALS = 0x80;
+static const int MAX_DISTANCE = 0xFFFF;
+static const int HASH_BITS = 12;
+
+CompressedPool::CompressedPool(int pageBytes, int poolBytes)
+    : pageBytes(pageBytes), blockBytes(pageBytes), classStep(64), maxObjectBytes(pageBytes * 3 / 4),
+      storedBytes(0), stores(0), loads(0), incompressible(0), poolFull(0) {
+    int blocks = poolBytes / blockBytes;
+    arena.assign((size_t)blocks * blockBytes, 0);
+    for (int b = blocks - 1; b >= 0; b--) {
+        freeBlocks.push_back(b);
+    }
+    blockClass.assign(blocks, -1);
+    blockUsed.assign(blocks, 0);
+    freeObjects.resize(maxObjectBytes / classStep);
+    hashTable.resize(1 << HASH_BITS);
+    scratch.resize(pageBytes);
+}
+
+int CompressedPool::classOf(int length) const {
+    return (length + classStep - 1) / classStep - 1;
+}
+
+int CompressedPool::objectBytes(int sizeClass) const {
+    return (sizeClass + 1) * classStep;
+}
+
+int CompressedPool::allocateObject(int sizeClass) {
+    std::vector<int>& objects = freeObjects[sizeClass];
+    if (objects.empty()) {
+        // 该级别没有空闲对象：取一个空闲块切成等长的对象
+        if (freeBlocks.empty()) {
+            return -1;
+        }
+        int block = freeBlocks.back();
+        freeBlocks.pop_back();
+        blockClass[block] = sizeClass;
+        int size = objectBytes(sizeClass);
+        for (int offset = blockBytes / size * size - size; offset >= 0; offset -= size) {
+            objects.push_back(block * blockBytes + offset);
+        }
+    }
+    int handle = objects.back();
+    objects.pop_back();
+    blockUsed[handle / blockBytes]++;
+    return handle;
+}
+
+void CompressedPool::freeObject(int handle, int sizeClass) {
+    int block = handle / blockBytes;
+    std::vector<int>& objects = freeObjects[sizeClass];
+    objects.push_back(handle);
+    if (--blockUsed[block] > 0) {
+        return;
+    }
+
+    // 块内对象全部空闲：整块归还，可改作其他级别
+    objects.erase(std::remove_if(objects.begin(), objects.end(),
+                                 [this, block](int object) { return object / blockBytes == block; }),
+                  objects.end());
+    blockClass[block] = -1;
+    freeBlocks.push_back(block);
+}
+
+int CompressedPool::compress(const char* source, char* target, int limit) {
+    std::fill(hashTable.begin(), hashTable.end(), -1);
+    int in = 0;
+    int out = 0;
+    int literalStart = 0;
+
+    // 输出 [literalStart, end) 之间尚未输出的字面字节
+    auto flushLiterals = [&](int end) {
+        while (literalStart < end) {
+            int run = std::min(end - literalStart, MAX_LITERALS);
+            if (out + 1 + run > limit) return false;
+            target[out++] = (char)(run - 1);
+            memcpy(target + out, source + literalStart, run);
+            out += run;
+            literalStart += run;
+        }
+        return true;
+    };
+
+    while (in + MIN_MATCH <= pageBytes) {
+        uint32_t word;
+        memcpy(&word, source + in, sizeof(word));
+        int slot = (int)((word * 2654435761u) >> (32 - HASH_BITS));
+        int candidate = hashTable[slot];
+        hashTable[slot] = in;
+        if (candidate < 0 || in - candidate > MAX_DISTANCE || memcmp(source + candidate, source + in, MIN_MATCH) != 0) {
+            in++;
+            continue;
+        }
+
+        int length = MIN_MATCH;
+        while (in + length < pageBytes && length < MAX_MATCH && source[candidate + length] == source[in + length]) {
+            length++;
+        }
+        if (!flushLiterals(in) || out + 3 > limit) {
+            return -1;
+        }
+        int distance = in - candidate;
+        target[out++] = (char)(0x80 | (length - MIN_MATCH));
+        target[out++] = (char)(distance & 0xFF);
+        target[out++] = (char)(distance >> 8);
+        in += length;
+        literalStart = in;
+    }
+    if (!flushLiterals(pageBytes)) {
+        return -1;
+    }
+    return out;
+}
+
+bool CompressedPool::decompress(const char* source, int length, char* target) const {
+    int in = 0;
+    int out = 0;
+    while (in < length) {
+        unsigned char control = (unsigned char)source[in++];
+        if (control < 0x80) {
+            int run = control + 1;
+            if (in + run > length || out + run > pageBytes) return false;
+            memcpy(target + out, source + in, run);
+            in += run;
+            out += run;
+            continue;
+        }
+        if (in + 2 > length) return false;
+        int matchLength = (control & 0x7F) + MIN_MATCH;
+        int distance = (unsigned char)source[in] | ((unsigned char)source[in + 1] << 8);
+        in += 2;
+        if (distance == 0 || distance > out || out + matchLength > pageBytes) return false;
+        // 距离可能小于长度（重复模式），逐字节复制
+        for (int i = 0; i < matchLength; i++, out++) {
+            target[out] = target[out - distance];
+        }
+    }
+    return out == pageBytes;
+}
+
+int CompressedPool::store(const char* page, int processId, long long pageNumber) {
+    int length = compress(page, scratch.data(), maxObjectBytes);
+    if (length < 0) {
+        incompressible++;
+        return INCOMPRESSIBLE;
+    }
+    int sizeClass = classOf(length);
+    int handle = allocateObject(sizeClass);
+    if (handle < 0) {
+        poolFull++;
+        return POOL_FULL;
+    }
+
+    memcpy(&arena[handle], scratch.data(), length);
+    Entry entry;
+    entry.processId = processId;
+    entry.pageNumber = pageNumber;
+    entry.length = length;
+    entry.sizeClass = sizeClass;
+    entry.order = lruOrder.insert(lruOrder.end(), handle);
+    entries[handle] = entry;
+    storedBytes += length;
+    stores++;
+    return handle;
+}
+
+bool CompressedPool::load(int handle, char* page) {
+    auto it = entries.find(handle);
+    if (it == entries.end()) {
+        return false;
+    }
+    loads++;
+    return decompress(&arena[handle], it->second.length, page);
+}
+
+void CompressedPool::release(int handle) {
+    auto it = entries.find(handle);
+    if (it == entries.end()) {
+        return;
+    }
+    storedBytes -= it->second.length;
+    freeObject(handle, it->second.sizeClass);
+    lruOrder.erase(it->second.order);
+    entries.erase(it);
+}
+
+void CompressedPool::oldestHandles(int count, std::vector<int>& handles) const {
+    handles.clear();
+    for (auto it = lruOrder.begin(); it != lruOrder.end() && (int)handles.size() < count; ++it) {
+        handles.push_back(*it);
+    }
+}
+
+bool CompressedPool::getOwner(int handle, int& processId, long long& pageNumber) const {
+    auto it = entries.find(handle);
+    if (it == entries.end()) {
+        return false;
+    }
+    processId = it->second.processId;
+    pageNumber = it->second.pageNumber;
+    return true;
+}
+
+int CompressedPool::getStoredPages() const {
+    return (int)entries.size();
+}
+
+long long CompressedPool::getStoredBytes() const {
+    return storedBytes;
+}
+
+long long CompressedPool::getUsedBytes() const {
+    return (long long)(blockClass.size() - freeBlocks.size()) * blockBytes;
+}
+
+void CompressedPool::showStatus() const {
+    long long originalBytes = (long long)entries.size() * pageBytes;
+    std::cout << "压缩池: " << entries.size() << " 页 (" << originalBytes / 1024 << "KB) 压缩为 "
+              << storedBytes / 1024 << "KB, 占用 " << getUsedBytes() / 1024 << "/" << arena.size() / 1024
+              << "KB, 有效压缩比 " << std::fixed << std::setprecision(2)
+              << (getUsedBytes() ? (double)originalBytes / getUsedBytes() : 0.0) << std::endl;
+    std::cout << "压缩池存入 " << stores << " 次, 取出 " << loads << " 次, 不可压缩 " << incompressible
+              << " 次, 池满 " << poolFull << " 次" << std::endl;
+}
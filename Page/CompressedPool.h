@@ -0,0 +1,74 @@
+#ifndef COMPRESSEDPOOL_H
+#define COMPRESSEDPOOL_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+// 压缩内存池：换出的页先经 LZ 压缩放在内存里，再次访问时解压，比读交换区快得多
+// 池是一块预先分配的内存，按块划分，每块归属一个大小级别并切成等长的对象（类似 zsmalloc）；
+// 压缩后超过页大小 3/4 的页视为不可压缩，由调用者直接写入交换区
+class CompressedPool {
+private:
+    struct Entry {
+        int processId;
+        long long pageNumber;
+        int length;                     // 压缩后的字节数
+        int sizeClass;
+        std::list<int>::iterator order; // 在 lruOrder 中的位置
+    };
+
+    int pageBytes;
+    int blockBytes;                     // 一个块的字节数
+    int classStep;                      // 相邻大小级别的对象长度之差
+    int maxObjectBytes;                 // 超过此长度视为不可压缩
+    std::vector<char> arena;
+    std::vector<int> freeBlocks;               // 未归属任何级别的块
+    std::vector<int> blockClass;               // 各块的大小级别，-1 表示空闲
+    std::vector<int> blockUsed;                // 各块中已用的对象数
+    std::vector<std::vector<int>> freeObjects; // 各级别的空闲对象（池内偏移）
+    std::unordered_map<int, Entry> entries;    // 句柄（池内偏移）-> 对象信息
+    std::list<int> lruOrder;                   // 按存入先后排列的句柄，表头最早
+
+    std::vector<int> hashTable;         // 压缩时的匹配查找表
+    std::vector<char> scratch;          // 压缩输出缓冲
+
+    long long storedBytes;              // 压缩后数据的总字节数
+    long long stores;
+    long long loads;
+    long long incompressible;
+    long long poolFull;
+
+    int classOf(int length) const;
+    int objectBytes(int sizeClass) const;
+    int allocateObject(int sizeClass);
+    void freeObject(int handle, int sizeClass);
+
+    int compress(const char* source, char* target, int limit);
+    bool decompress(const char* source, int length, char* target) const;
+
+public:
+    static const int INCOMPRESSIBLE = -1;
+    static const int POOL_FULL = -2;
+
+    CompressedPool(int pageBytes, int poolBytes);
+
+    // 压缩一页存入池中，返回句柄；不可压缩返回 INCOMPRESSIBLE，池中没有空间返回 POOL_FULL
+    int store(const char* page, int processId, long long pageNumber);
+
+    // 解压到 page（pageBytes 字节）
+    bool load(int handle, char* page);
+    void release(int handle);
+
+    // 按存入先后取最早的至多 count 个对象，用于把冷页写回交换区；对象仍留在池中，写回成功后由调用者释放
+    void oldestHandles(int count, std::vector<int>& handles) const;
+    bool getOwner(int handle, int& processId, long long& pageNumber) const;
+
+    int getStoredPages() const;
+    long long getStoredBytes() const;
+    long long getUsedBytes() const;     // 已归属大小级别的块占用的池空间
+
+    void showStatus() const;
+};
+
+#endif // COMPRESSEDPOOL_H
@@ -1,279 +1,3222 @@
-#include <iostream>
-#include <vector>
-#include <map>
-#include <queue>
-#include <iomanip>
-#include <algorithm>
-#include <cstring>
-
-class PagingMemoryManager {
-private:
-    struct PageFrame {
-        bool occupied;      // 页框是否被占用
-        int processId;      // 占用该页框的进程ID
-        int pageNumber;     // 逻辑页号
-        
-        PageFrame() : occupied(false), processId(-1), pageNumber(-1) {}
+#include "PageMng.h"
+#include "TraceReplay.h"
+#include <new>
+#include <sys/mman.h>
+
+// 线性页表最多覆盖 2^20 页（4KB 页即 32 位地址空间），更大的稀疏空间请用多级页表
+static const long long FLAT_MAX_PAGES = 1LL << 20;
+
+// NUMA 距离：本地 10（与 ACPI SLIT 一致），本地访存延迟按 100ns 计，远端按距离比例放大
+static const int LOCAL_DISTANCE = 10;
+static const int REMOTE_DISTANCE = 21;
+static const int LOCAL_LATENCY_NS = 100;
+
+// 预读窗口：识别出顺序访问时从最小窗口开始，窗口内的页都被用到后加倍
+static const int READAHEAD_MIN_PAGES = 2;
+static const int READAHEAD_MAX_PAGES = 32;
+
+// 后台回收每批从轮转窗口中选冷页，窗口为本批页数的这么多倍
+static const int COLD_SCAN_FACTOR = 2;
+
+// nonResidentPages 中表示页在压缩池中
+static const int COMPRESSED_SLOT = -2;
+
+// 进程表按进程ID直接下标，进程ID不能超过此值
+static const int MAX_PROCESS_ID = 1 << 20;
+
+// 连续分配失败时同步规整最多迁移的页数，剩余工作留给后台
+static const int DIRECT_COMPACT_PAGES = 32;
+
+// 用户地址空间上限（字节，同 x86-64 的 47 位用户空间），栈顶不超过它，逻辑地址不会溢出；
+// 堆与栈之间至少保留的保护页数
+static const long long USER_SPACE_BYTES = 1LL << 47;
+static const long long SEGMENT_GUARD_PAGES = 1;
+
+PagingMemoryManager::PageFrame::PageFrame()
+    : occupied(false), processId(-1), pageNumber(-1), hashNext(-1), referenced(false), dirty(false),
+      loadTime(0), lastAccess(0), huge(false), shareCount(0), merged(false), pinned(false), age(0),
+      recent(false), prefetched(false), selected(false), written(false) {}
+
+void PagingMemoryManager::FrameList::reset(int frames) {
+    prev.assign(frames, (int)NOT_LINKED);
+    next.assign(frames, (int)NOT_LINKED);
+    head = -1;
+    tail = -1;
+}
+
+bool PagingMemoryManager::FrameList::contains(int frameNumber) const {
+    return prev[frameNumber] != NOT_LINKED;
+}
+
+void PagingMemoryManager::FrameList::pushBack(int frameNumber) {
+    if (contains(frameNumber)) {
+        remove(frameNumber);
+    }
+    prev[frameNumber] = tail;
+    next[frameNumber] = -1;
+    if (tail != -1) {
+        next[tail] = frameNumber;
+    } else {
+        head = frameNumber;
+    }
+    tail = frameNumber;
+}
+
+void PagingMemoryManager::FrameList::remove(int frameNumber) {
+    if (!contains(frameNumber)) return;
+    int before = prev[frameNumber];
+    int after = next[frameNumber];
+    if (before != -1) next[before] = after; else head = after;
+    if (after != -1) prev[after] = before; else tail = before;
+    prev[frameNumber] = NOT_LINKED;
+    next[frameNumber] = NOT_LINKED;
+}
+
+void PagingMemoryManager::FrameList::replace(int from, int to) {
+    if (!contains(from)) return;
+    int before = prev[from];
+    int after = next[from];
+    prev[to] = before;
+    next[to] = after;
+    if (before != -1) next[before] = to; else head = to;
+    if (after != -1) prev[after] = to; else tail = to;
+    prev[from] = NOT_LINKED;
+    next[from] = NOT_LINKED;
+}
+
+PagingMemoryManager::SharedSegment::SharedSegment() : segmentId(-1), attachCount(0) {}
+
+PagingMemoryManager::ProcessInfo::ProcessInfo()
+    : processId(-1), pageCount(0), referenceCount(0), pageFaults(0), swappedOut(false),
+      lastFaultPage(-1), faultStride(0), readaheadNext(-1), readaheadWindow(READAHEAD_MIN_PAGES),
+      codePages(0), heapPages(0), heapBreak(0), stackPages(0), homeNode(0), numaPolicy(NUMA_LOCAL_FIRST), bindNode(-1), interleaveNext(0),
+      localAccesses(0), remoteAccesses(0) {}
+
+void PagingMemoryManager::ProcessInfo::reset() {
+    processId = -1;
+    pageCount = 0;
+    pageTable.clear();
+    if (radixTable) {
+        radixTable->clear();
+    }
+    hugePages.clear();
+    sharedAttachments.clear();
+    mergedPages.clear();
+    referenceWindow.clear();
+    windowCounts.clear();
+    referenceCount = 0;
+    nonResidentPages.clear();
+    compressedPages.clear();
+    pageFaults = 0;
+    swappedOut = false;
+    lastFaultPage = -1;
+    faultStride = 0;
+    readaheadNext = -1;
+    readaheadWindow = READAHEAD_MIN_PAGES;
+    codePages = 0;
+    heapPages = 0;
+    heapBreak = 0;
+    stackPages = 0;
+    homeNode = 0;
+    numaPolicy = NUMA_LOCAL_FIRST;
+    bindNode = -1;
+    interleaveNext = 0;
+    localAccesses = 0;
+    remoteAccesses = 0;
+}
+
+PagingMemoryManager::PagingMemoryManager(int frames, int size, PageTableType type)
+    : totalFrames(frames), frameSize(size), pageTableType(type), processCount(0), verbose(true),
+      nextSegmentId(1),
+      workingSetWindow(100), swapBatchSize(8), swapClusterSize(8),
+      compressedOut(0), compressedFaults(0), compressedWriteback(0), replacementPolicy(CLOCK_REPLACEMENT), clockHand(0), coldHand(0), accessClock(0),
+      committedPages(0), reservedPages(0), pageFaultCount(0), demandZeroFaults(0), clusterReadPages(0),
+      reclaimActive(false), reclaimWakeups(0), reclaimedPages(0), directReclaims(0),
+      readaheadLimit(READAHEAD_MAX_PAGES), readaheadBatches(0), prefetchedPages(0), prefetchHits(0),
+      prefetchWasted(0), transferCalls(0), transferRuns(0), transferBytes(0), transferNanos(0),
+      zeroFrame(-1), scanCursor(0), mergedMappings(0), pagesScanned(0), zeroPagesMerged(0), cowBreaks(0),
+      compactionOrder(-1), compactionNode(0), compactionRequests(0), pagesMigrated(0),
+      hugePageOrder(0), tlb(16, 0), hugePromotions(0), hugeDemotions(0),
+      framesPerNode(frames), cpusPerNode(1), defaultNumaPolicy(NUMA_LOCAL_FIRST),
+      localAccessCount(0), remoteAccessCount(0), accessLatencyNanos(0) {
+    // 所有页框初始即由伙伴系统管理为空闲；未配置 NUMA 时只有一个节点
+    physicalMemory.resize(totalFrames);
+    loadOrder.reset(totalFrames);
+    accessOrder.reset(totalFrames);
+    // 匿名映射的页由内核按需清零，首次访问前不占用宿主机内存
+    physicalBytes = (size_t)totalFrames * frameSize * 1024;
+    void* base = mmap(nullptr, physicalBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    physicalBase = static_cast<char*>(base);
+    nodeAllocators.push_back(BuddyAllocator(0, totalFrames));
+    nodeDistance.assign(1, std::vector<int>(1, LOCAL_DISTANCE));
+    nodeFallback.assign(1, std::vector<int>(1, 0));
+    resetCompactionCursors();
+
+    // 默认水位：min 取总页框的 1/64（至少 1 页），low、high 分别为其 2、3 倍
+    minWatermark = std::max(1, totalFrames / 64);
+    lowWatermark = std::min(minWatermark * 2, totalFrames - 1);
+    highWatermark = std::min(minWatermark * 3, totalFrames - 1);
+
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        // 锚点数取不小于页框数的 2 的幂，平均链长不超过 1
+        int anchors = 1;
+        while (anchors < totalFrames) anchors <<= 1;
+        hashAnchor.assign(anchors, -1);
+    }
+
+    std::cout << "分页式存储管理系统初始化完成" << std::endl;
+    std::cout << "总页框数: " << totalFrames << std::endl;
+    std::cout << "页框大小: " << frameSize << "KB" << std::endl;
+    std::cout << "总内存大小: " << totalFrames * frameSize << "KB" << std::endl;
+    std::cout << "页表类型: ";
+    switch (pageTableType) {
+        case TWO_LEVEL_PAGE_TABLE: std::cout << "二级页表"; break;
+        case FOUR_LEVEL_PAGE_TABLE: std::cout << "四级页表"; break;
+        case INVERTED_PAGE_TABLE: std::cout << "哈希倒排页表"; break;
+        default: std::cout << "线性页表"; break;
+    }
+    std::cout << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+}
+
+PagingMemoryManager::~PagingMemoryManager() {
+    munmap(physicalBase, physicalBytes);
+}
+
+PagingMemoryManager::ProcessInfo* PagingMemoryManager::findProcess(int processId) {
+    if (processId < 0 || processId >= (int)processTable.size()) {
+        return nullptr;
+    }
+    ProcessInfo* process = processTable[processId].get();
+    return process && process->processId != -1 ? process : nullptr;
+}
+
+PagingMemoryManager::ProcessInfo* PagingMemoryManager::acquireProcess(int processId) {
+    // 返回一个空的表项，调用者填好 processId 后进程才算存在
+    if (processId >= (int)processTable.size()) {
+        processTable.resize(std::max(processId + 1, (int)processTable.size() * 2));
+    }
+    std::unique_ptr<ProcessInfo>& slot = processTable[processId];
+    if (!slot) {
+        slot.reset(new ProcessInfo());
+    } else {
+        slot->reset();
+    }
+    return slot.get();
+}
+
+int PagingMemoryManager::nodeOf(int frameNumber) const {
+    return std::min(frameNumber / framesPerNode, (int)nodeAllocators.size() - 1);
+}
+
+int PagingMemoryManager::boundNode(const ProcessInfo& process) const {
+    return process.bindNode == -1 ? process.homeNode : process.bindNode;
+}
+
+int PagingMemoryManager::freeFrameCount() const {
+    int total = 0;
+    for (const BuddyAllocator& node : nodeAllocators) {
+        total += node.getFreeCount();
+    }
+    return total;
+}
+
+int PagingMemoryManager::availableFrames(const ProcessInfo& process) const {
+    if (process.numaPolicy == NUMA_BIND) {
+        return nodeAllocators[boundNode(process)].getFreeCount();
+    }
+    return freeFrameCount();
+}
+
+int PagingMemoryManager::allocateFrames(ProcessInfo& process, int order) {
+    if (process.numaPolicy == NUMA_BIND) {
+        return nodeAllocators[boundNode(process)].allocate(order);
+    }
+
+    int nodes = (int)nodeAllocators.size();
+    if (process.numaPolicy == NUMA_INTERLEAVE) {
+        for (int i = 0; i < nodes; i++) {
+            int node = (process.interleaveNext + i) % nodes;
+            int frameNum = nodeAllocators[node].allocate(order);
+            if (frameNum != -1) {
+                process.interleaveNext = (node + 1) % nodes;
+                return frameNum;
+            }
+        }
+        return -1;
+    }
+
+    for (int node : nodeFallback[process.homeNode]) {
+        int frameNum = nodeAllocators[node].allocate(order);
+        if (frameNum != -1) return frameNum;
+    }
+    return -1;
+}
+
+void PagingMemoryManager::allocateFrameBatch(ProcessInfo& process, int count, std::vector<int>& frames) {
+    // 调用者已确认 count 不超过 availableFrames
+    if (process.numaPolicy == NUMA_INTERLEAVE) {
+        for (int i = 0; i < count; i++) {
+            frames.push_back(allocateFrames(process, 0));
+        }
+        return;
+    }
+    if (process.numaPolicy == NUMA_BIND) {
+        nodeAllocators[boundNode(process)].allocateBatch(count, frames);
+        return;
+    }
+
+    // 本地优先：本地节点能给多少给多少，其余由近及远
+    int remaining = count;
+    for (int node : nodeFallback[process.homeNode]) {
+        int take = std::min(remaining, nodeAllocators[node].getFreeCount());
+        if (take > 0) {
+            nodeAllocators[node].allocateBatch(take, frames);
+            remaining -= take;
+        }
+        if (remaining == 0) break;
+    }
+}
+
+void PagingMemoryManager::freeFrames(int frameNumber, int order) {
+    nodeAllocators[nodeOf(frameNumber)].free(frameNumber, order);
+}
+
+int PagingMemoryManager::hashSlot(int processId, long long pageNumber) const {
+    unsigned long long key = ((unsigned long long)(unsigned)processId << 40) ^ (unsigned long long)pageNumber;
+    key *= 0x9E3779B97F4A7C15ULL;  // Fibonacci 散列
+    return (int)((key >> 32) & (hashAnchor.size() - 1));
+}
+
+void PagingMemoryManager::unlinkFrame(int frameNumber) {
+    PageFrame& frame = physicalMemory[frameNumber];
+    int* link = &hashAnchor[hashSlot(frame.processId, frame.pageNumber)];
+    while (*link != -1 && *link != frameNumber) {
+        link = &physicalMemory[*link].hashNext;
+    }
+    if (*link == frameNumber) {
+        *link = frame.hashNext;
+    }
+    frame.hashNext = -1;
+}
+
+int PagingMemoryManager::lookupPage(const ProcessInfo& process, long long pageNumber) const {
+    if (!process.hugePages.empty()) {
+        auto huge = process.hugePages.find(pageNumber >> hugePageOrder);
+        if (huge != process.hugePages.end()) {
+            return huge->second + (int)(pageNumber & ((1LL << hugePageOrder) - 1));
+        }
+    }
+    if (!process.mergedPages.empty()) {
+        auto merged = process.mergedPages.find(pageNumber);
+        if (merged != process.mergedPages.end()) {
+            return merged->second;
+        }
+    }
+    if (!process.sharedAttachments.empty()) {
+        // 共享段的各页由段内页框数组直接给出，所有挂接者共用
+        auto attachment = process.sharedAttachments.upper_bound(pageNumber);
+        if (attachment != process.sharedAttachments.begin()) {
+            --attachment;
+            const SharedSegment& segment = sharedSegments.at(attachment->second);
+            long long index = pageNumber - attachment->first;
+            if (index < (long long)segment.frames.size()) {
+                return segment.frames[index];
+            }
+        }
+    }
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        // 沿散列链比较页框中记录的 (进程ID, 逻辑页号)
+        for (int f = hashAnchor[hashSlot(process.processId, pageNumber)]; f != -1;
+             f = physicalMemory[f].hashNext) {
+            if (physicalMemory[f].processId == process.processId &&
+                physicalMemory[f].pageNumber == pageNumber) {
+                return f;
+            }
+        }
+        return -1;
+    }
+    if (process.radixTable) {
+        return process.radixTable->lookup(pageNumber);
+    }
+    if (pageNumber < 0 || pageNumber >= (long long)process.pageTable.size()) {
+        return -1;
+    }
+    return process.pageTable[pageNumber];
+}
+
+bool PagingMemoryManager::mapPage(ProcessInfo& process, long long pageNumber, int frameNumber) {
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        // 页框本身就是表项：登记所有者并挂入散列链
+        PageFrame& frame = physicalMemory[frameNumber];
+        frame.processId = process.processId;
+        frame.pageNumber = pageNumber;
+        int& anchor = hashAnchor[hashSlot(process.processId, pageNumber)];
+        frame.hashNext = anchor;
+        anchor = frameNumber;
+        return true;
+    }
+    if (process.radixTable) {
+        return process.radixTable->map(pageNumber, frameNumber);
+    }
+    if (pageNumber < 0 || pageNumber >= FLAT_MAX_PAGES) {
+        return false;
+    }
+    // 线性页表只能整段扩展到该页号为止
+    if (pageNumber >= (long long)process.pageTable.size()) {
+        process.pageTable.resize(pageNumber + 1, -1);
+    }
+    process.pageTable[pageNumber] = frameNumber;
+    return true;
+}
+
+void PagingMemoryManager::forEachMapping(const ProcessInfo& process,
+                                         const std::function<void(long long, int)>& visit) const {
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        // 倒排页表没有进程私有结构，扫描页框数组
+        for (int i = 0; i < totalFrames; i++) {
+            if (physicalMemory[i].occupied && physicalMemory[i].processId == process.processId) {
+                visit(physicalMemory[i].pageNumber, i);
+            }
+        }
+        return;
+    }
+    if (process.radixTable) {
+        process.radixTable->forEach(visit);
+    } else {
+        for (size_t i = 0; i < process.pageTable.size(); i++) {
+            if (process.pageTable[i] != -1) {
+                visit((long long)i, process.pageTable[i]);
+            }
+        }
+    }
+    for (auto& huge : process.hugePages) {
+        for (int i = 0; i < (1 << hugePageOrder); i++) {
+            visit((huge.first << hugePageOrder) + i, huge.second + i);
+        }
+    }
+}
+
+long long PagingMemoryManager::stackTopPage(const ProcessInfo& process) const {
+    // 栈从页表能表示的最高页向下增长，与页大小和页表组织方式无关；
+    // 线性页表在栈首次使用时整段扩展到这里，多级页表与倒排页表只为用到的页分配表项
+    return std::min(virtualPageLimit(process), USER_SPACE_BYTES / ((long long)frameSize * 1024));
+}
+
+long long PagingMemoryManager::virtualPageLimit(const ProcessInfo& process) const {
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        return 1LL << 52;  // 64 位地址空间去掉 12 位页内偏移
+    }
+    if (process.radixTable) {
+        return process.radixTable->getMaxVirtualPages();
+    }
+    return FLAT_MAX_PAGES;
+}
+
+bool PagingMemoryManager::checkRegion(ProcessInfo& process, long long firstPage, long long lastPage) {
+    if (firstPage < 0 || lastPage >= virtualPageLimit(process)) {
+        std::cout << "区域映射失败: 页号 " << lastPage << " 超出页表范围" << std::endl;
+        return false;
+    }
+    for (long long page = firstPage; page <= lastPage; page++) {
+        if (lookupPage(process, page) != -1) {
+            std::cout << "区域映射失败: 页 " << page << " 已映射" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void PagingMemoryManager::installFrames(ProcessInfo& process, long long firstPage,
+                                        const std::vector<int>& frames) {
+    for (size_t i = 0; i < frames.size(); i++) {
+        int frameNum = frames[i];
+
+        // 更新页框信息
+        physicalMemory[frameNum].occupied = true;
+        physicalMemory[frameNum].processId = process.processId;
+        physicalMemory[frameNum].pageNumber = firstPage + i;
+        physicalMemory[frameNum].referenced = true;
+        physicalMemory[frameNum].dirty = false;
+        physicalMemory[frameNum].loadTime = ++accessClock;
+        physicalMemory[frameNum].lastAccess = accessClock;
+        physicalMemory[frameNum].huge = false;
+        physicalMemory[frameNum].pinned = false;
+        physicalMemory[frameNum].age = 0;
+        physicalMemory[frameNum].recent = true;
+        physicalMemory[frameNum].prefetched = false;
+        physicalMemory[frameNum].written = false;
+        loadOrder.pushBack(frameNum);
+        accessOrder.pushBack(frameNum);
+
+        // 更新页表
+        mapPage(process, firstPage + i, frameNum);
+    }
+}
+
+size_t PagingMemoryManager::pageTableMemory(const ProcessInfo& process) const {
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        return 0;  // 全局共享，见 getTotalPageTableMemory
+    }
+    size_t hugeEntries = process.hugePages.size() * sizeof(int);
+    if (process.radixTable) {
+        return process.radixTable->getMemoryUsage() + hugeEntries;
+    }
+    return process.pageTable.size() * sizeof(int) + hugeEntries;
+}
+
+// 为进程分配内存
+bool PagingMemoryManager::allocateMemory(int processId, int memorySize, int cpu) {
+    // 计算需要的页数
+    int pagesNeeded = (memorySize + frameSize - 1) / frameSize;  // 向上取整
+
+    // 检查进程是否已存在
+    if (processId < 0 || processId > MAX_PROCESS_ID) {
+        std::cout << "内存分配失败: 进程ID " << processId << " 超出进程表范围" << std::endl;
+        return false;
+    }
+    if (findProcess(processId)) {
+        std::cout << "内存分配失败: 进程 " << processId << " 已存在" << std::endl;
+        return false;
+    }
+
+    // 直接在进程表中就地构造进程信息：本地节点由 CPU 决定，未指定时取空闲页框最多的节点
+    ProcessInfo& process = *acquireProcess(processId);
+    process.numaPolicy = defaultNumaPolicy;
+    if (cpu >= 0) {
+        process.homeNode = cpu / cpusPerNode % (int)nodeAllocators.size();
+    } else {
+        for (int node = 1; node < (int)nodeAllocators.size(); node++) {
+            if (nodeAllocators[node].getFreeCount() > nodeAllocators[process.homeNode].getFreeCount()) {
+                process.homeNode = node;
+            }
+        }
+    }
+
+    if (swapArea) {
+        // 有交换区时只受 物理页框 + 交换槽位 的总量限制，其他进程的预留不可占用
+        if (committedPages + reservedPages + pagesNeeded > commitLimit()) {
+            std::cout << "内存分配失败: 进程 " << processId
+                      << " 需要 " << pagesNeeded << " 页，超出内存与交换区总容量" << std::endl;
+            return false;
+        }
+    } else if (pagesNeeded + reservedPages > availableFrames(process)) {
+        std::cout << "内存分配失败: 进程 " << processId
+                  << " 需要 " << pagesNeeded << " 页，但只有 "
+                  << std::max(0LL, availableFrames(process) - reservedPages) << " 页可用" << std::endl;
+        return false;
+    }
+
+    process.processId = processId;
+    process.pageCount = pagesNeeded;
+    process.codePages = pagesNeeded;
+    process.heapBreak = (long long)pagesNeeded * frameSize * 1024;
+    processCount++;
+    if (pageTableType == FLAT_PAGE_TABLE) {
+        process.pageTable.assign(pagesNeeded, -1);
+    } else if (!process.radixTable) {
+        // 复用的表项保留已清空的多级页表
+        if (pageTableType == TWO_LEVEL_PAGE_TABLE) {
+            process.radixTable = std::make_shared<RadixPageTable>(2, 10);
+        } else if (pageTableType == FOUR_LEVEL_PAGE_TABLE) {
+            process.radixTable = std::make_shared<RadixPageTable>(4, 9);
+        }
+    }
+
+    // 一次调用取齐进程的全部页框；空闲页框不足的部分留待首次访问时调入
+    // 有交换区时不动用 min 水位以下的页框，缺页处理总有空闲页框可用
+    int residentPages = std::min(pagesNeeded, availableFrames(process));
+    if (swapArea) {
+        residentPages = std::max(0, std::min(residentPages, freeFrameCount() - minWatermark));
+    }
+    frameBatch.clear();
+    allocateFrameBatch(process, residentPages, frameBatch);
+    installFrames(process, 0, frameBatch);
+    for (int i = residentPages; i < pagesNeeded; i++) {
+        process.nonResidentPages[i] = -1;
+    }
+    committedPages += pagesNeeded;
+
+    if (verbose) {
+        std::cout << "内存分配成功: 进程 " << processId
+                  << " 分配了 " << pagesNeeded << " 页 ("
+                  << memorySize << "KB)" << std::endl;
+        std::cout << "分配的页框: ";
+        for (int frame : frameBatch) {
+            std::cout << frame << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    if (hugePageOrder > 0) {
+        promoteHugePages(processId);
+    }
+    return true;
+}
+
+// 在任意虚拟地址处映射一段内存
+bool PagingMemoryManager::mapRegion(int processId, long long virtualAddress, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process) {
+        std::cout << "区域映射失败: 进程 " << processId << " 不存在" << std::endl;
+        return false;
+    }
+
+    if (virtualAddress < 0 || memorySize <= 0) {
+        std::cout << "区域映射失败: 无效的地址或大小" << std::endl;
+        return false;
+    }
+
+    long long pageBytes = (long long)frameSize * 1024;
+    long long firstPage = virtualAddress / pageBytes;
+    long long lastPage = (virtualAddress + (long long)memorySize * 1024 - 1) / pageBytes;
+    int pagesNeeded = (int)(lastPage - firstPage + 1);
+    if (pagesNeeded > availableFrames(*process)) {
+        std::cout << "区域映射失败: 需要 " << pagesNeeded << " 页，但只有 "
+                  << availableFrames(*process) << " 页可用" << std::endl;
+        return false;
+    }
+    if (committedPages + reservedPages + pagesNeeded > commitLimit()) {
+        // 其他进程的预留不可占用
+        std::cout << "区域映射失败: 需要 " << pagesNeeded << " 页，超出可提交的总量" << std::endl;
+        return false;
+    }
+    if (!checkRegion(*process, firstPage, lastPage)) {
+        return false;
+    }
+
+    std::vector<int> frames;
+    frames.reserve(pagesNeeded);
+    allocateFrameBatch(*process, pagesNeeded, frames);
+    installFrames(*process, firstPage, frames);
+    process->pageCount += pagesNeeded;
+    committedPages += pagesNeeded;
+    if (hugePageOrder > 0) {
+        promoteHugePages(processId);
+    }
+
+    std::cout << "区域映射成功: 进程 " << processId << " 在虚拟页 " << firstPage
+              << " 处映射了 " << pagesNeeded << " 页，页表占用 "
+              << pageTableMemory(*process) << " 字节" << std::endl;
+    return true;
+}
+
+// 保留一段虚拟地址，页框在首次访问时分配
+bool PagingMemoryManager::reservePages(int processId, long long virtualAddress, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || virtualAddress < 0 || memorySize <= 0) {
+        return false;
+    }
+
+    long long pageBytes = (long long)frameSize * 1024;
+    long long firstPage = virtualAddress / pageBytes;
+    long long lastPage = (virtualAddress + (long long)memorySize * 1024 - 1) / pageBytes;
+    return reserveRange(*process, firstPage, lastPage);
+}
+
+bool PagingMemoryManager::reserveRange(ProcessInfo& process, long long firstPage, long long lastPage) {
+    if (firstPage < 0 || lastPage >= virtualPageLimit(process)) {
+        return false;
+    }
+    for (long long page = firstPage; page <= lastPage; page++) {
+        if (lookupPage(process, page) != -1 || process.nonResidentPages.count(page)) {
+            return false;
+        }
+    }
+
+    for (long long page = firstPage; page <= lastPage; page++) {
+        process.nonResidentPages[page] = -1;
+    }
+    int pages = (int)(lastPage - firstPage + 1);
+    process.pageCount += pages;
+    committedPages += pages;
+    return true;
+}
+
+// 映射一段物理连续的内存
+int PagingMemoryManager::mapContiguousRegion(int processId, long long virtualAddress, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process) {
+        std::cout << "连续映射失败: 进程 " << processId << " 不存在" << std::endl;
+        return -1;
+    }
+    if (virtualAddress < 0 || memorySize <= 0) {
+        std::cout << "连续映射失败: 无效的地址或大小" << std::endl;
+        return -1;
+    }
+
+    long long pageBytes = (long long)frameSize * 1024;
+    long long firstPage = virtualAddress / pageBytes;
+    int pagesNeeded = (int)((virtualAddress + (long long)memorySize * 1024 - 1) / pageBytes - firstPage + 1);
+    if (!checkRegion(*process, firstPage, firstPage + pagesNeeded - 1)) {
+        return -1;
+    }
+    if (committedPages + reservedPages + pagesNeeded > commitLimit()) {
+        std::cout << "连续映射失败: 需要 " << pagesNeeded << " 页，超出可提交的总量" << std::endl;
+        return -1;
+    }
+
+    // 向上取整到 2 的幂，多出的尾部页框立即归还
+    int order = 0;
+    while ((1 << order) < pagesNeeded) order++;
+    int baseFrame = allocateFrames(*process, order);
+    if (baseFrame == -1) {
+        // 空闲页框够但不连续：触发规整，先同步迁移一批页后重试，不够时留给后台继续
+        requestCompaction(order, process->numaPolicy == NUMA_BIND ? boundNode(*process) : process->homeNode);
+        compactMemory(DIRECT_COMPACT_PAGES);
+        baseFrame = allocateFrames(*process, order);
+    }
+    if (baseFrame == -1) {
+        std::cout << "连续映射失败: 没有 " << (1 << order) << " 个连续空闲页框 (空闲 "
+                  << freeFrameCount() << " 页，碎片率 " << std::fixed
+                  << std::setprecision(2) << getFragmentation() * 100
+                  << "%)" << std::endl;
+        return -1;
+    }
+    for (int i = pagesNeeded; i < (1 << order); i++) {
+        freeFrames(baseFrame + i, 0);
+    }
+
+    std::vector<int> frames;
+    frames.reserve(pagesNeeded);
+    for (int i = 0; i < pagesNeeded; i++) {
+        frames.push_back(baseFrame + i);
+    }
+    installFrames(*process, firstPage, frames);
+    for (int frameNum : frames) {
+        physicalMemory[frameNum].pinned = true;  // 物理地址交给了设备，不能再迁移
+    }
+    process->pageCount += pagesNeeded;
+    committedPages += pagesNeeded;
+
+    std::cout << "连续映射成功: 进程 " << processId << " 虚拟页 " << firstPage
+              << " 起 " << pagesNeeded << " 页 -> 页框 " << baseFrame << "~"
+              << baseFrame + pagesNeeded - 1 << std::endl;
+    return baseFrame;
+}
+
+// 回收进程内存
+bool PagingMemoryManager::deallocateMemory(int processId) {
+    ProcessInfo* found = findProcess(processId);
+    if (!found) {
+        std::cout << "内存回收失败: 进程 " << processId << " 不存在" << std::endl;
+        return false;
+    }
+
+    ProcessInfo& process = *found;
+    int pageCount = process.pageCount;  // 保存页数，因为后面会清空进程信息
+
+    // 解除所有共享段挂接，共享页框由最后一个挂接者回收
+    while (!process.sharedAttachments.empty()) {
+        detachAttachment(process, process.sharedAttachments.begin());
+    }
+
+    // 解除对合并页框的引用
+    while (!process.mergedPages.empty()) {
+        dropMergedPage(process, process.mergedPages.begin());
+    }
+
+    // 释放所有页框
+    frameBatch.clear();
+    forEachMapping(process, [this](long long, int frameNum) {
+        if (pageTableType == INVERTED_PAGE_TABLE) {
+            unlinkFrame(frameNum);
+        }
+
+        // 重置页框信息并归还伙伴系统，与空闲伙伴合并
+        releaseFrame(frameNum);
+        frameBatch.push_back(frameNum);
+    });
+
+    // 释放已换出页占用的交换槽位和压缩池对象
+    for (auto& entry : process.nonResidentPages) {
+        if (entry.second >= 0) {
+            swapArea->freeSlot(entry.second);
+        }
+    }
+    for (auto& entry : process.compressedPages) {
+        compressedPool->release(entry.second);
+    }
+    committedPages -= pageCount;
+    tlb.invalidateProcess(processId);
+
+    // 清空进程信息，表项留给之后的进程复用
+    process.reset();
+    processCount--;
+
+    if (verbose) {
+        std::cout << "内存回收成功: 进程 " << processId
+                  << " 释放了 " << pageCount << " 页" << std::endl;
+        std::cout << "释放的页框: ";
+        for (int frame : frameBatch) {
+            std::cout << frame << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    return true;
+}
+
+// 回收进程的一段虚拟地址
+bool PagingMemoryManager::unmapRegion(int processId, long long virtualAddress, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || virtualAddress < 0 || memorySize <= 0) {
+        std::cout << "区域回收失败: 进程 " << processId << " 不存在或参数无效" << std::endl;
+        return false;
+    }
+
+    long long pageBytes = (long long)frameSize * 1024;
+    long long firstPage = virtualAddress / pageBytes;
+    long long lastPage = (virtualAddress + (long long)memorySize * 1024 - 1) / pageBytes;
+    int freedPages = releaseRange(*process, firstPage, lastPage);
+
+    std::cout << "区域回收: 进程 " << processId << " 虚拟页 " << firstPage << "~" << lastPage
+              << " 释放了 " << freedPages << " 页" << std::endl;
+    return freedPages > 0;
+}
+
+int PagingMemoryManager::releaseRange(ProcessInfo& process, long long firstPage, long long lastPage) {
+    int freedPages = 0;
+    for (long long page = firstPage; page <= lastPage; page++) {
+        auto merged = process.mergedPages.find(page);
+        if (merged != process.mergedPages.end()) {
+            dropMergedPage(process, merged);
+            freedPages++;
+            continue;
+        }
+        int frameNum = lookupPage(process, page);
+        if (frameNum != -1 && physicalMemory[frameNum].shareCount > 0) {
+            continue;  // 共享段只能整体解除挂接
+        }
+        if (frameNum != -1) {
+            unmapPage(process, page, frameNum);  // 部分释放大页时先拆分
+            releaseFrame(frameNum);
+        } else {
+            auto entry = process.nonResidentPages.find(page);
+            if (entry == process.nonResidentPages.end()) continue;
+            if (entry->second >= 0) {
+                swapArea->freeSlot(entry->second);
+            } else if (entry->second == COMPRESSED_SLOT) {
+                compressedPool->release(process.compressedPages[page]);
+                process.compressedPages.erase(page);
+            }
+            process.nonResidentPages.erase(entry);
+        }
+        freedPages++;
+    }
+    process.pageCount -= freedPages;
+    committedPages -= freedPages;
+    return freedPages;
+}
+
+long long PagingMemoryManager::commitLimit() const {
+    return totalFrames + (swapArea ? swapArea->getSlotCount() : 0);
+}
+
+// 预留内存
+bool PagingMemoryManager::reserveMemory(int processId, int memorySize) {
+    int pagesNeeded = (memorySize + frameSize - 1) / frameSize;
+    if (processId < 0 || processId > MAX_PROCESS_ID || memorySize < 0 ||
+        findProcess(processId) || reservations.count(processId)) {
+        return false;
+    }
+    if (committedPages + reservedPages + pagesNeeded > commitLimit()) {
+        return false;
+    }
+    reservations[processId] = pagesNeeded;
+    reservedPages += pagesNeeded;
+    return true;
+}
+
+// 提交预留：先释放预留再按原大小分配，分配失败时恢复预留
+bool PagingMemoryManager::commitMemory(int processId, int cpu) {
+    auto it = reservations.find(processId);
+    if (it == reservations.end()) {
+        return false;
+    }
+    int pages = it->second;
+    reservations.erase(it);
+    reservedPages -= pages;
+    if (!allocateMemory(processId, pages * frameSize, cpu)) {
+        reservations[processId] = pages;
+        reservedPages += pages;
+        return false;
+    }
+    return true;
+}
+
+bool PagingMemoryManager::cancelReservation(int processId) {
+    auto it = reservations.find(processId);
+    if (it == reservations.end()) {
+        return false;
+    }
+    reservedPages -= it->second;
+    reservations.erase(it);
+    return true;
+}
+
+bool PagingMemoryManager::hasReservation(int processId) {
+    return reservations.count(processId) > 0;
+}
+
+bool PagingMemoryManager::isAllocated(int processId) {
+    return findProcess(processId) != nullptr;
+}
+
+long long PagingMemoryManager::getReservedPages() {
+    return reservedPages;
+}
+
+// 创建分段地址空间
+bool PagingMemoryManager::createAddressSpace(int processId, int codeSize, int heapSize, int stackSize, int cpu) {
+    if (codeSize <= 0 || heapSize < 0 || stackSize < 0) {
+        std::cout << "地址空间创建失败: 无效的段大小" << std::endl;
+        return false;
+    }
+    if (!allocateMemory(processId, codeSize, cpu)) {
+        return false;
+    }
+    if (!growSegment(processId, HEAP_SEGMENT, heapSize) || !growSegment(processId, STACK_SEGMENT, stackSize)) {
+        deallocateMemory(processId);
+        return false;
+    }
+    return true;
+}
+
+bool PagingMemoryManager::resizeSegment(ProcessInfo& process, SegmentType segment, long long pages) {
+    long long pageBytes = (long long)frameSize * 1024;
+    if (segment == CODE_SEGMENT) {
+        std::cout << "段调整失败: 代码段大小不可改变" << std::endl;
+        return false;
+    }
+    long long& current = segment == HEAP_SEGMENT ? process.heapPages : process.stackPages;
+    if (pages < 0 || pages == current) {
+        return pages == current;
+    }
+
+    long long heapEnd = process.codePages + process.heapPages;   // 堆之后的第一页
+    long long stackBottom = stackTopPage(process) - process.stackPages; // 栈的最低页
+    long long delta = pages - current;
+    if (delta < 0) {
+        // 收缩：释放堆顶或栈底的页，页框、交换槽位与压缩池对象随之归还
+        long long firstPage = segment == HEAP_SEGMENT ? heapEnd + delta : stackBottom;
+        releaseRange(process, firstPage, firstPage - delta - 1);
+    } else {
+        long long firstPage = segment == HEAP_SEGMENT ? heapEnd : stackBottom - delta;
+        if (heapEnd + (segment == HEAP_SEGMENT ? delta : 0) + SEGMENT_GUARD_PAGES >
+            stackBottom - (segment == STACK_SEGMENT ? delta : 0)) {
+            std::cout << "段调整失败: 进程 " << process.processId << " 的堆与栈将会相接" << std::endl;
+            return false;
+        }
+
+        // 新增的页只在页表中登记，首次访问时填零调入；提交总量不超过页框与交换槽位之和，保证缺页总能满足
+        if (committedPages + reservedPages + delta > commitLimit()) {
+            std::cout << "段调整失败: 进程 " << process.processId << " 需要 " << delta
+                      << " 页，超出可提交的总量" << std::endl;
+            return false;
+        }
+        if (!reserveRange(process, firstPage, firstPage + delta - 1)) {
+            std::cout << "段调整失败: 进程 " << process.processId << " 虚拟页 " << firstPage << "~"
+                      << firstPage + delta - 1 << " 已被占用" << std::endl;
+            return false;
+        }
+    }
+    current = pages;
+    if (segment == HEAP_SEGMENT) {
+        process.heapBreak = (process.codePages + process.heapPages) * pageBytes;
+    }
+
+    if (verbose) {
+        std::cout << "段调整: 进程 " << process.processId << (segment == HEAP_SEGMENT ? " 堆" : " 栈")
+                  << (delta > 0 ? " 增长 " : " 收缩 ") << (delta > 0 ? delta : -delta) << " 页，现为 " << pages << " 页"
+                  << std::endl;
+    }
+    return true;
+}
+
+bool PagingMemoryManager::growSegment(int processId, SegmentType segment, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || memorySize < 0) {
+        std::cout << "段调整失败: 进程 " << processId << " 不存在或参数无效" << std::endl;
+        return false;
+    }
+    long long current = segment == HEAP_SEGMENT ? process->heapPages : process->stackPages;
+    return resizeSegment(*process, segment, current + (memorySize + frameSize - 1) / frameSize);
+}
+
+bool PagingMemoryManager::shrinkSegment(int processId, SegmentType segment, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || memorySize < 0) {
+        std::cout << "段调整失败: 进程 " << processId << " 不存在或参数无效" << std::endl;
+        return false;
+    }
+    long long current = segment == HEAP_SEGMENT ? process->heapPages : process->stackPages;
+    long long pages = memorySize / frameSize;  // 只释放完整的页
+    if (pages > current) {
+        std::cout << "段调整失败: 进程 " << processId << " 的段只有 " << current << " 页" << std::endl;
+        return false;
+    }
+    return resizeSegment(*process, segment, current - pages);
+}
+
+long long PagingMemoryManager::setBreak(int processId, long long address) {
+    ProcessInfo* process = findProcess(processId);
+    long long pageBytes = (long long)frameSize * 1024;
+    if (!process || address < process->codePages * pageBytes) {
+        return -1;
+    }
+    long long pages = (address + pageBytes - 1) / pageBytes - process->codePages;
+    if (!resizeSegment(*process, HEAP_SEGMENT, pages)) {
+        return -1;
+    }
+    process->heapBreak = address;  // 堆顶可以不在页边界上
+    return address;
+}
+
+long long PagingMemoryManager::getBreak(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    return process ? process->heapBreak : -1;
+}
+
+long long PagingMemoryManager::getStackTop(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    return process ? stackTopPage(*process) * frameSize * 1024 : -1;
+}
+
+void PagingMemoryManager::showSegments(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process) {
+        std::cout << "进程 " << processId << " 不存在" << std::endl;
+        return;
+    }
+
+    long long pageBytes = (long long)frameSize * 1024;
+    long long ranges[3][2] = {
+        {0, process->codePages},
+        {process->codePages, process->codePages + process->heapPages},
+        {stackTopPage(*process) - process->stackPages, stackTopPage(*process)},
     };
-    
-    struct ProcessInfo {
+    const char* names[3] = {"代码段", "堆", "栈"};
+    std::cout << "进程 " << processId << " 地址空间 (堆顶 0x" << std::hex << process->heapBreak << std::dec
+              << "):" << std::endl;
+    for (int i = 0; i < 3; i++) {
+        int resident = 0;
+        for (long long page = ranges[i][0]; page < ranges[i][1]; page++) {
+            if (lookupPage(*process, page) != -1) resident++;
+        }
+        std::cout << "  " << names[i] << "\t0x" << std::hex << ranges[i][0] * pageBytes << " - 0x"
+                  << ranges[i][1] * pageBytes << std::dec << "\t" << ranges[i][1] - ranges[i][0]
+                  << " 页, 驻留 " << resident << " 页" << std::endl;
+    }
+}
+
+// 创建共享内存段
+int PagingMemoryManager::createSharedSegment(int processId, long long virtualAddress, int memorySize) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || virtualAddress < 0 || memorySize <= 0) {
+        std::cout << "共享段创建失败: 进程 " << processId << " 不存在或参数无效" << std::endl;
+        return -1;
+    }
+
+    // 共享页框常驻内存，必须立即取齐
+    int pages = (memorySize + frameSize - 1) / frameSize;
+    if (pages > availableFrames(*process)) {
+        std::cout << "共享段创建失败: 需要 " << pages << " 页，但只有 "
+                  << availableFrames(*process) << " 页可用" << std::endl;
+        return -1;
+    }
+    if (committedPages + reservedPages + pages > commitLimit()) {
+        std::cout << "共享段创建失败: 需要 " << pages << " 页，超出可提交的总量" << std::endl;
+        return -1;
+    }
+
+    SharedSegment segment;
+    segment.segmentId = nextSegmentId++;
+    allocateFrameBatch(*process, pages, segment.frames);
+    for (int i = 0; i < pages; i++) {
+        PageFrame& frame = physicalMemory[segment.frames[i]];
+        frame.occupied = true;
+        frame.processId = -1;
+        frame.pageNumber = i;
+        frame.referenced = true;
+        frame.dirty = false;
+        frame.huge = false;
+        frame.loadTime = ++accessClock;
+        frame.lastAccess = accessClock;
+    }
+    committedPages += pages;
+    int segmentId = segment.segmentId;
+    sharedSegments[segmentId] = segment;
+
+    if (!attachSharedSegment(segmentId, processId, virtualAddress)) {
+        for (int frameNum : sharedSegments[segmentId].frames) {
+            releaseFrame(frameNum);
+        }
+        committedPages -= pages;
+        sharedSegments.erase(segmentId);
+        return -1;
+    }
+
+    std::cout << "共享段创建成功: 段 " << segmentId << " 共 " << pages << " 页" << std::endl;
+    return segmentId;
+}
+
+// 挂接共享内存段
+bool PagingMemoryManager::attachSharedSegment(int segmentId, int processId, long long virtualAddress) {
+    ProcessInfo* process = findProcess(processId);
+    auto it = sharedSegments.find(segmentId);
+    if (!process || it == sharedSegments.end() || virtualAddress < 0) {
+        std::cout << "共享段挂接失败: 进程 " << processId << " 或段 " << segmentId << " 不存在" << std::endl;
+        return false;
+    }
+
+    SharedSegment& segment = it->second;
+    long long pageBytes = (long long)frameSize * 1024;
+    long long firstPage = virtualAddress / pageBytes;
+    long long lastPage = firstPage + (long long)segment.frames.size() - 1;
+    if (!checkRegion(*process, firstPage, lastPage)) {
+        return false;
+    }
+    for (long long page = firstPage; page <= lastPage; page++) {
+        if (process->nonResidentPages.count(page)) {
+            std::cout << "共享段挂接失败: 页 " << page << " 已被保留" << std::endl;
+            return false;
+        }
+    }
+
+    process->sharedAttachments[firstPage] = segmentId;
+    segment.attachCount++;
+    for (int frameNum : segment.frames) {
+        physicalMemory[frameNum].shareCount++;
+    }
+
+    std::cout << "共享段挂接: 段 " << segmentId << " -> 进程 " << processId << " 虚拟页 "
+              << firstPage << "~" << lastPage << " (挂接数 " << segment.attachCount << ")" << std::endl;
+    return true;
+}
+
+void PagingMemoryManager::detachAttachment(ProcessInfo& process,
+                                           std::map<long long, int>::iterator attachment) {
+    long long firstPage = attachment->first;
+    auto it = sharedSegments.find(attachment->second);
+    process.sharedAttachments.erase(attachment);
+
+    SharedSegment& segment = it->second;
+    for (size_t i = 0; i < segment.frames.size(); i++) {
+        tlb.invalidate(process.processId, firstPage + (long long)i);
+        physicalMemory[segment.frames[i]].shareCount--;
+    }
+    if (--segment.attachCount > 0) {
+        return;
+    }
+
+    // 最后一个挂接者：回收页框
+    for (int frameNum : segment.frames) {
+        releaseFrame(frameNum);
+    }
+    committedPages -= (long long)segment.frames.size();
+    std::cout << "共享段 " << segment.segmentId << " 已回收 " << segment.frames.size() << " 页" << std::endl;
+    sharedSegments.erase(it);
+}
+
+// 解除共享段挂接
+bool PagingMemoryManager::detachSharedSegment(int processId, long long virtualAddress) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process) {
+        return false;
+    }
+    long long firstPage = virtualAddress / ((long long)frameSize * 1024);
+    auto attachment = process->sharedAttachments.find(firstPage);
+    if (attachment == process->sharedAttachments.end()) {
+        std::cout << "共享段解除失败: 进程 " << processId << " 在虚拟页 " << firstPage
+                  << " 处没有挂接" << std::endl;
+        return false;
+    }
+
+    std::cout << "共享段解除: 段 " << attachment->second << " <- 进程 " << processId << std::endl;
+    detachAttachment(*process, attachment);
+    return true;
+}
+
+// 逻辑地址转换为物理地址
+long long PagingMemoryManager::translateAddress(int processId, long long logicalAddress) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process) {
+        std::cout << "地址转换失败: 进程 " << processId << " 不存在" << std::endl;
+        return -1;
+    }
+
+    // 计算页号和页内偏移
+    long long pageBytes = (long long)frameSize * 1024;  // 转换为字节
+    long long pageNumber = logicalAddress / pageBytes;
+    long long offset = logicalAddress % pageBytes;
+
+    int frameNumber = lookupPage(*process, pageNumber);
+    if (frameNumber == -1 && process->nonResidentPages.count(pageNumber)) {
+        std::cout << "缺页中断: 进程 " << processId << " 页 " << pageNumber << std::endl;
+        if (handlePageFault(*process, pageNumber)) {
+            frameNumber = lookupPage(*process, pageNumber);
+        }
+    }
+    if (frameNumber == -1) {
+        if (pageTableType == FLAT_PAGE_TABLE && pageNumber >= (long long)process->pageTable.size()) {
+            std::cout << "地址转换失败: 页号 " << pageNumber << " 超出范围" << std::endl;
+        } else {
+            std::cout << "地址转换失败: 页 " << pageNumber << " 未分配" << std::endl;
+        }
+        return -1;
+    }
+
+    long long physicalAddress = frameNumber * pageBytes + offset;
+    if (cacheModel) {
+        cacheModel->access(processId, physicalAddress);
+    }
+
+    std::cout << "地址转换: 进程 " << processId
+              << " 逻辑地址 " << logicalAddress
+              << " -> 物理地址 " << physicalAddress
+              << " (页号:" << pageNumber << ", 页框:" << frameNumber
+              << ", 偏移:" << offset << (physicalMemory[frameNumber].huge ? ", 大页" : "")
+              << (physicalMemory[frameNumber].shareCount > 0 ? ", 共享" : "")
+              << ")" << std::endl;
+
+    return physicalAddress;
+}
+
+void PagingMemoryManager::recordReference(ProcessInfo& process, long long pageNumber) {
+    process.referenceCount++;
+    process.referenceWindow.push_back(pageNumber);
+    process.windowCounts[pageNumber]++;
+
+    // 滑出窗口的引用
+    while ((int)process.referenceWindow.size() > workingSetWindow) {
+        long long oldPage = process.referenceWindow.front();
+        process.referenceWindow.pop_front();
+        auto it = process.windowCounts.find(oldPage);
+        if (--it->second == 0) {
+            process.windowCounts.erase(it);
+        }
+    }
+}
+
+int PagingMemoryManager::workingSetOf(const ProcessInfo& process) const {
+    if (process.referenceCount == 0) {
+        // 没有访问记录，保守地按全部页估计；已合并的页在总和中按合并页框计
+        return process.pageCount - (int)process.mergedPages.size();
+    }
+    return (int)process.windowCounts.size();
+}
+
+// 进程访问逻辑地址
+bool PagingMemoryManager::accessMemory(int processId, long long logicalAddress, bool write) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || logicalAddress < 0) {
+        return false;
+    }
+    long long pageBytes = (long long)frameSize * 1024;
+    int frameNumber = touchPage(*process, logicalAddress / pageBytes, write);
+    if (frameNumber == -1) {
+        return false;
+    }
+    if (cacheModel) {
+        cacheModel->access(processId, frameNumber * pageBytes + logicalAddress % pageBytes);
+    }
+    return true;
+}
+
+char* PagingMemoryManager::frameBytes(int frameNumber) {
+    return physicalBase + (size_t)frameNumber * frameSize * 1024;
+}
+
+int PagingMemoryManager::touchPage(ProcessInfo& process, long long pageNumber, bool write) {
+    int processId = process.processId;
+    int frameNumber = tlb.lookup(processId, pageNumber);
+    if (frameNumber == -1) {
+        // 快表未命中：查页表，大页只占一个快表项
+        frameNumber = lookupPage(process, pageNumber);
+        if (frameNumber == -1) {
+            if (!handlePageFault(process, pageNumber)) {
+                return -1;
+            }
+            frameNumber = lookupPage(process, pageNumber);
+        }
+        if (physicalMemory[frameNumber].huge) {
+            int offset = (int)(pageNumber & ((1LL << hugePageOrder) - 1));
+            tlb.insert(processId, pageNumber, frameNumber - offset, true);
+        } else {
+            tlb.insert(processId, pageNumber, frameNumber, false);
+        }
+    }
+    if (write && physicalMemory[frameNumber].merged) {
+        frameNumber = breakCow(process, pageNumber);
+        if (frameNumber == -1) {
+            return -1;
+        }
+        tlb.insert(processId, pageNumber, frameNumber, false);
+    }
+
+    if (physicalMemory[frameNumber].prefetched) {
+        physicalMemory[frameNumber].prefetched = false;
+        prefetchHits++;
+    }
+    physicalMemory[frameNumber].referenced = true;
+    physicalMemory[frameNumber].recent = true;
+    physicalMemory[frameNumber].lastAccess = ++accessClock;
+    if (accessOrder.contains(frameNumber)) {
+        accessOrder.pushBack(frameNumber);
+    }
+    if (write) {
+        physicalMemory[frameNumber].dirty = true;
+        physicalMemory[frameNumber].written = true;
+    }
+
+    // 按本地节点到页框所在节点的距离计算访存延迟
+    int node = nodeOf(frameNumber);
+    if (node == process.homeNode) {
+        process.localAccesses++;
+        localAccessCount++;
+    } else {
+        process.remoteAccesses++;
+        remoteAccessCount++;
+    }
+    accessLatencyNanos += LOCAL_LATENCY_NS * nodeDistance[process.homeNode][node] / LOCAL_DISTANCE;
+    process.swappedOut = false;
+    if (physicalMemory[frameNumber].shareCount == 0) {
+        recordReference(process, pageNumber);  // 共享页常驻，在工作集总和中只按页框计一次
+    }
+    return frameNumber;
+}
+
+int PagingMemoryManager::translateRun(ProcessInfo& process, long long logicalAddress, int length,
+                                      bool write, char*& bytes) {
+    long long pageBytes = (long long)frameSize * 1024;
+    long long pageNumber = logicalAddress / pageBytes;
+    int frameNumber = touchPage(process, pageNumber, write);
+    if (frameNumber == -1) {
+        return 0;
+    }
+    bytes = frameBytes(frameNumber) + logicalAddress % pageBytes;
+    long long run = pageBytes - logicalAddress % pageBytes;
+
+    // 后续页已驻留且页框紧接前一页时并入本段；不会缺页，已取得的页框不会被换出
+    while (run < length) {
+        int next = lookupPage(process, pageNumber + 1);
+        if (next != frameNumber + 1 || (write && physicalMemory[next].merged)) {
+            break;
+        }
+        frameNumber = touchPage(process, ++pageNumber, write);
+        run += pageBytes;
+    }
+    return (int)std::min<long long>(run, length);
+}
+
+void PagingMemoryManager::recordTransfer(long long bytes, std::chrono::steady_clock::time_point start) {
+    transferCalls++;
+    transferBytes += bytes;
+    transferNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void PagingMemoryManager::feedCacheModel() {
+    // 缓存模型的模拟开销不计入拷贝耗时，拷贝中途失败时已完成的部分照样送入
+    for (const CacheRange& range : pendingRanges) {
+        cacheModel->accessRange(range.processId, range.address, range.length);
+    }
+    pendingRanges.clear();
+}
+
+// 写进程内存
+bool PagingMemoryManager::writeMemory(int processId, long long logicalAddress, const void* data, int length) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || logicalAddress < 0 || length < 0) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const char* source = static_cast<const char*>(data);
+    int remaining = length;
+    while (remaining > 0) {
+        char* bytes;
+        int run = translateRun(*process, logicalAddress, remaining, true, bytes);
+        if (run == 0) {
+            feedCacheModel();
+            return false;
+        }
+        memcpy(bytes, source, run);
+        if (cacheModel) {
+            pendingRanges.push_back(CacheRange{processId, bytes - physicalBase, run});
+        }
+        transferRuns++;
+        logicalAddress += run;
+        source += run;
+        remaining -= run;
+    }
+    recordTransfer(length, start);
+    feedCacheModel();
+    return true;
+}
+
+// 读进程内存
+bool PagingMemoryManager::readMemory(int processId, long long logicalAddress, void* data, int length) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || logicalAddress < 0 || length < 0) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    char* target = static_cast<char*>(data);
+    int remaining = length;
+    while (remaining > 0) {
+        char* bytes;
+        int run = translateRun(*process, logicalAddress, remaining, false, bytes);
+        if (run == 0) {
+            feedCacheModel();
+            return false;
+        }
+        memcpy(target, bytes, run);
+        if (cacheModel) {
+            pendingRanges.push_back(CacheRange{processId, bytes - physicalBase, run});
+        }
+        transferRuns++;
+        logicalAddress += run;
+        target += run;
+        remaining -= run;
+    }
+    recordTransfer(length, start);
+    feedCacheModel();
+    return true;
+}
+
+bool PagingMemoryManager::loadWord(int processId, long long logicalAddress, uint64_t& value) {
+    return readMemory(processId, logicalAddress, &value, sizeof(value));
+}
+
+bool PagingMemoryManager::storeWord(int processId, long long logicalAddress, uint64_t value) {
+    return writeMemory(processId, logicalAddress, &value, sizeof(value));
+}
+
+// 进程间（或进程内）拷贝
+bool PagingMemoryManager::copyMemory(int destinationProcessId, long long destination,
+                                     int sourceProcessId, long long source, int length) {
+    ProcessInfo* to = findProcess(destinationProcessId);
+    ProcessInfo* from = findProcess(sourceProcessId);
+    if (!to || !from || destination < 0 || source < 0 || length < 0) {
+        return false;
+    }
+    if (destinationProcessId == sourceProcessId &&
+        destination < source + length && source < destination + length) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long pageBytes = (long long)frameSize * 1024;
+    int remaining = length;
+    while (remaining > 0) {
+        char* sourceBytes;
+        int run = translateRun(*from, source, remaining, false, sourceBytes);
+        if (run == 0) {
+            feedCacheModel();
+            return false;
+        }
+
+        // 翻译目标段时可能缺页换出，先临时固定源段的页框
+        int firstFrame = (int)((sourceBytes - physicalBase) / pageBytes);
+        int lastFrame = (int)((sourceBytes + run - 1 - physicalBase) / pageBytes);
+        frameBatch.clear();
+        for (int frameNum = firstFrame; frameNum <= lastFrame; frameNum++) {
+            if (!physicalMemory[frameNum].pinned) {
+                physicalMemory[frameNum].pinned = true;
+                frameBatch.push_back(frameNum);
+            }
+        }
+        char* destinationBytes;
+        int chunk = translateRun(*to, destination, run, true, destinationBytes);
+        for (int frameNum : frameBatch) {
+            physicalMemory[frameNum].pinned = false;
+        }
+        if (chunk == 0) {
+            feedCacheModel();
+            return false;
+        }
+
+        memmove(destinationBytes, sourceBytes, chunk);  // 共享段可能使两段落在同一页框
+        if (cacheModel) {
+            pendingRanges.push_back(CacheRange{sourceProcessId, sourceBytes - physicalBase, chunk});
+            pendingRanges.push_back(CacheRange{destinationProcessId, destinationBytes - physicalBase, chunk});
+        }
+        transferRuns++;
+        destination += chunk;
+        source += chunk;
+        remaining -= chunk;
+    }
+    recordTransfer(length, start);
+    feedCacheModel();
+    return true;
+}
+
+void PagingMemoryManager::showBandwidthStatus() {
+    std::cout << "内存读写与拷贝: " << transferCalls << " 次, " << std::fixed << std::setprecision(2)
+              << transferBytes / (1024.0 * 1024.0) << "MB, " << transferRuns << " 段 (平均每段 "
+              << (transferRuns ? transferBytes / transferRuns / 1024 : 0) << "KB), 带宽 "
+              << (transferNanos ? transferBytes * 1000.0 / transferNanos : 0.0) << "MB/s" << std::endl;
+}
+
+bool PagingMemoryManager::enableCacheModel(const std::vector<CacheLevelConfig>& levels, int memoryCycles) {
+    if (!CacheHierarchy::isValidConfig(levels) || memoryCycles < 0) {
+        std::cout << "缓存模型启用失败: 配置无效" << std::endl;
+        return false;
+    }
+    cacheModel.reset(new CacheHierarchy(levels, memoryCycles));
+    return true;
+}
+
+CacheHierarchy* PagingMemoryManager::getCacheModel() {
+    return cacheModel.get();
+}
+
+void PagingMemoryManager::showCacheStatus() {
+    if (!cacheModel) {
+        std::cout << "缓存模型未启用" << std::endl;
+        return;
+    }
+    cacheModel->showStatus();
+}
+
+void PagingMemoryManager::unmapPage(ProcessInfo& process, long long pageNumber, int frameNumber) {
+    if (physicalMemory[frameNumber].huge) {
+        demoteHugePage(process, pageNumber >> hugePageOrder);
+    }
+    tlb.invalidate(process.processId, pageNumber);
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        unlinkFrame(frameNumber);
+    } else if (process.radixTable) {
+        process.radixTable->unmap(pageNumber);
+    } else if (pageNumber < (long long)process.pageTable.size()) {
+        process.pageTable[pageNumber] = -1;
+    }
+}
+
+int PagingMemoryManager::swapOutFrames(const std::vector<int>& victims) {
+    if (!compressedPool) {
+        return writeSwapSlots(victims);
+    }
+
+    // 先压缩进池，不可压缩（或池满且腾不出空间）的页写入交换区
+    std::vector<int> spill;
+    int compressed = 0;
+    for (int frameNum : victims) {
+        if (compressFrame(frameNum)) {
+            compressed++;
+        } else {
+            spill.push_back(frameNum);
+        }
+    }
+    return compressed + writeSwapSlots(spill);
+}
+
+bool PagingMemoryManager::compressFrame(int frameNumber) {
+    PageFrame& frame = physicalMemory[frameNumber];
+    ProcessInfo* owner = findProcess(frame.processId);
+    if (!owner) {
+        return false;
+    }
+    int handle = compressedPool->store(frameBytes(frameNumber), frame.processId, frame.pageNumber);
+    if (handle == CompressedPool::POOL_FULL && writebackCompressed(swapBatchSize) > 0) {
+        handle = compressedPool->store(frameBytes(frameNumber), frame.processId, frame.pageNumber);
+    }
+    if (handle < 0) {
+        return false;
+    }
+
+    unmapPage(*owner, frame.pageNumber, frameNumber);
+    owner->nonResidentPages[frame.pageNumber] = COMPRESSED_SLOT;
+    owner->compressedPages[frame.pageNumber] = handle;
+    if (frame.prefetched) {
+        owner->readaheadWindow /= 2;
+    }
+    releaseFrame(frameNumber);
+    compressedOut++;
+    return true;
+}
+
+int PagingMemoryManager::writebackCompressed(int count) {
+    // 把池中最早存入的页解压后整批写入连续槽位，找不到连续段时只写回一页
+    count = std::min(count, compressedPool->getStoredPages());
+    int firstSlot = count > 0 ? swapArea->allocateSlots(count) : -1;
+    if (firstSlot == -1 && count > 1) {
+        count = 1;
+        firstSlot = swapArea->allocateSlots(1);
+    }
+    if (firstSlot == -1) {
+        return 0;
+    }
+
+    // 先解压到缓冲区整批写出，写入成功后才从池中释放；失败时页仍留在池中
+    int pageBytes = frameSize * 1024;
+    std::vector<int> handles;
+    compressedPool->oldestHandles(count, handles);
+    ioBuffer.resize((size_t)count * pageBytes);
+    for (int i = 0; i < count; i++) {
+        if (!compressedPool->load(handles[i], &ioBuffer[(size_t)i * pageBytes])) {
+            std::cout << "压缩池写回失败: 对象 " << handles[i] << " 解压出错，页仍留在池中" << std::endl;
+            for (int j = 0; j < count; j++) swapArea->freeSlot(firstSlot + j);
+            return 0;
+        }
+    }
+    if (!swapArea->writeSlots(firstSlot, count, ioBuffer.data())) {
+        for (int i = 0; i < count; i++) swapArea->freeSlot(firstSlot + i);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
         int processId;
-        int pageCount;      // 进程占用的页数
-        std::vector<int> pageTable;  // 页表：逻辑页号 -> 物理页框号
-        
-        ProcessInfo() : processId(-1), pageCount(0) {}
-        ProcessInfo(int id, int count) : processId(id), pageCount(count) {
-            pageTable.resize(count, -1);
+        long long pageNumber;
+        compressedPool->getOwner(handles[i], processId, pageNumber);
+        compressedPool->release(handles[i]);
+
+        ProcessInfo* owner = findProcess(processId);
+        owner->nonResidentPages[pageNumber] = firstSlot + i;
+        owner->compressedPages.erase(pageNumber);
+        swapArea->setSlotOwner(firstSlot + i, processId, pageNumber);
+    }
+    compressedWriteback += count;
+    return count;
+}
+
+int PagingMemoryManager::writeSwapSlots(const std::vector<int>& victims) {
+    if (victims.empty()) return 0;
+
+    int pageBytes = frameSize * 1024;
+    int count = (int)victims.size();
+
+    if (!swapArea) {
+        // 没有交换区：页面内容无处保存，由调用者只丢弃全零页（轨迹回放等不写内容的场景）
+        return 0;
+    }
+
+    // 优先整批写入连续槽位；找不到连续段时逐页分配
+    std::vector<int> slots(count, -1);
+    int firstSlot = swapArea->allocateSlots(count);
+    if (firstSlot != -1) {
+        for (int i = 0; i < count; i++) slots[i] = firstSlot + i;
+    } else {
+        for (int i = 0; i < count; i++) {
+            slots[i] = swapArea->allocateSlots(1);
+            if (slots[i] == -1) {
+                for (int j = 0; j < i; j++) swapArea->freeSlot(slots[j]);
+                std::cout << "换出失败: 交换区已满" << std::endl;
+                return 0;
+            }
+        }
+    }
+
+    // 受害页不一定物理相邻，先收集到缓冲区再一次写出
+    ioBuffer.resize((size_t)count * pageBytes);
+    for (int i = 0; i < count; i++) {
+        memcpy(&ioBuffer[(size_t)i * pageBytes], frameBytes(victims[i]), pageBytes);
+    }
+    bool written = true;
+    if (firstSlot != -1) {
+        written = swapArea->writeSlots(firstSlot, count, ioBuffer.data());
+    } else {
+        for (int i = 0; i < count && written; i++) {
+            written = swapArea->writeSlots(slots[i], 1, &ioBuffer[(size_t)i * pageBytes]);
+        }
+    }
+    if (!written) {
+        // 写入失败：释放槽位，页框保持驻留和映射，由调用者另选办法
+        for (int i = 0; i < count; i++) swapArea->freeSlot(slots[i]);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int frameNum = victims[i];
+        PageFrame& frame = physicalMemory[frameNum];
+        ProcessInfo* owner = findProcess(frame.processId);
+        if (owner) {
+            unmapPage(*owner, frame.pageNumber, frameNum);
+            owner->nonResidentPages[frame.pageNumber] = slots[i];
+            if (frame.prefetched) {
+                // 预读的页没用上就被换出：窗口减半，减到 0 后该步长下不再预读，直到访问模式改变
+                owner->readaheadWindow /= 2;
+            }
+        }
+        swapArea->setSlotOwner(slots[i], frame.processId, frame.pageNumber);
+        releaseFrame(frameNum);
+    }
+    return count;
+}
+
+int PagingMemoryManager::selectVictims(int count, std::vector<int>& victims, int node) {
+    // 已选中的页框打上标记，避免重复选择，返回前清除
+    for (int frameNum : victims) {
+        physicalMemory[frameNum].selected = true;
+    }
+    auto eligible = [this, node](int frameNum) {
+        const PageFrame& frame = physicalMemory[frameNum];
+        return frame.occupied && frame.shareCount == 0 && !frame.pinned && !frame.selected &&
+               (node == -1 || nodeOf(frameNum) == node);
+    };
+
+    if (replacementPolicy == CLOCK_REPLACEMENT) {
+        // 时钟（二次机会）算法：访问位为 1 的页清零后跳过
+        for (int scanned = 0; (int)victims.size() < count && scanned < 2 * totalFrames; scanned++) {
+            int frameNum = clockHand;
+            clockHand = (clockHand + 1) % totalFrames;
+
+            if (!eligible(frameNum)) continue;
+            PageFrame& frame = physicalMemory[frameNum];
+            if (frame.referenced) {
+                frame.referenced = false;
+                continue;
+            }
+            frame.selected = true;
+            victims.push_back(frameNum);
+        }
+    } else {
+        // FIFO 取调入链表、LRU 取访问链表，从表头（最老的页）依次选取
+        const FrameList& order = replacementPolicy == FIFO_REPLACEMENT ? loadOrder : accessOrder;
+        for (int frameNum = order.head; frameNum != -1 && (int)victims.size() < count;
+             frameNum = order.next[frameNum]) {
+            if (!eligible(frameNum)) continue;
+            physicalMemory[frameNum].selected = true;
+            victims.push_back(frameNum);
+        }
+    }
+
+    for (int frameNum : victims) {
+        physicalMemory[frameNum].selected = false;
+    }
+    return (int)victims.size();
+}
+
+int PagingMemoryManager::evictPages(int count, int node) {
+    std::vector<int> victims;
+    selectVictims(count, victims, node);
+    int evicted = swapOutFrames(victims);
+    if (evicted == 0) {
+        evicted = discardZeroFrames(victims);
+    }
+    return evicted;
+}
+
+int PagingMemoryManager::discardZeroFrames(const std::vector<int>& victims) {
+    // 换出失败时的退路：全零页不需要保存内容，丢弃后再次访问按首次访问重新分配清零页框
+    int discarded = 0;
+    for (int frameNum : victims) {
+        PageFrame& frame = physicalMemory[frameNum];
+        ProcessInfo* owner = findProcess(frame.processId);
+        if (!owner || !isZeroFrame(frameNum)) continue;
+        unmapPage(*owner, frame.pageNumber, frameNum);
+        owner->nonResidentPages[frame.pageNumber] = -1;
+        releaseFrame(frameNum);
+        discarded++;
+    }
+    return discarded;
+}
+
+void PagingMemoryManager::agePages() {
+    // 老化算法：recent 位移入老化计数的最高位后清零，计数反映最近 8 次扫描中的访问情况
+    // 只清自己的位；访问位留给时钟算法，否则每次扫描后所有页都没有第二次机会，时钟退化为 FIFO
+    for (PageFrame& frame : physicalMemory) {
+        if (!frame.occupied) continue;
+        frame.age = (unsigned char)((frame.age >> 1) | (frame.recent ? 0x80 : 0));
+        frame.recent = false;
+    }
+}
+
+int PagingMemoryManager::selectColdVictims(int count, std::vector<int>& victims) {
+    // 从上次停下的位置继续，只收集 count 的 COLD_SCAN_FACTOR 倍个候选页，取其中老化计数最小的
+    // （相同时取最久未访问的）；窗口随指针在物理内存中轮转，每批的代价与内存大小无关
+    coldCandidates.clear();
+    int window = count * COLD_SCAN_FACTOR;
+    for (int scanned = 0; scanned < totalFrames && (int)coldCandidates.size() < window; scanned++) {
+        const PageFrame& frame = physicalMemory[coldHand];
+        if (frame.occupied && frame.shareCount == 0 && !frame.pinned) {
+            coldCandidates.push_back(coldHand);
+        }
+        coldHand = (coldHand + 1) % totalFrames;
+    }
+    count = std::min(count, (int)coldCandidates.size());
+    std::partial_sort(coldCandidates.begin(), coldCandidates.begin() + count, coldCandidates.end(),
+                      [this](int a, int b) {
+                          const PageFrame& x = physicalMemory[a];
+                          const PageFrame& y = physicalMemory[b];
+                          return x.age != y.age ? x.age < y.age : x.lastAccess < y.lastAccess;
+                      });
+    victims.assign(coldCandidates.begin(), coldCandidates.begin() + count);
+    return count;
+}
+
+bool PagingMemoryManager::installFromSlot(ProcessInfo& process, long long pageNumber, int slot,
+                                          const char* data) {
+    // 换出时登记的槽位所有者应与缺页的页一致；不一致时不换入，槽位与表项保持原样
+    int storedPid = -1;
+    long long storedPage = -1;
+    if (!swapArea->getSlotOwner(slot, storedPid, storedPage) ||
+        storedPid != process.processId || storedPage != pageNumber) {
+        std::cout << "换入校验失败: 槽位 " << slot << " 中是进程 " << storedPid
+                  << " 的页 " << storedPage << std::endl;
+        return false;
+    }
+
+    int frameNum = allocateFrames(process, 0);
+    memcpy(frameBytes(frameNum), data, frameSize * 1024);
+    installFrames(process, pageNumber, std::vector<int>(1, frameNum));
+    physicalMemory[frameNum].written = true;
+    process.nonResidentPages.erase(pageNumber);
+    swapArea->freeSlot(slot);
+    return true;
+}
+
+bool PagingMemoryManager::handlePageFault(ProcessInfo& process, long long pageNumber) {
+    if (!process.nonResidentPages.count(pageNumber)) {
+        return false;  // 非法访问：该页不属于进程
+    }
+
+    pageFaultCount++;
+    process.pageFaults++;
+
+    // 没有可用页框时整批换出（无交换区时只能丢弃全零页）；绑定节点的进程只换出该节点的页
+    if (availableFrames(process) == 0) {
+        directReclaims++;
+        if (evictPages(swapArea ? swapBatchSize : 1,
+                       process.numaPolicy == NUMA_BIND ? boundNode(process) : -1) == 0) {
+            std::cout << "缺页处理失败: 内存不足，没有可换出或丢弃的页框" << std::endl;
+            return false;
+        }
+    }
+
+    // 换出可能把本页从压缩池写回交换区，也可能使散列表扩容，因此换出之后再取表项
+    auto it = process.nonResidentPages.find(pageNumber);
+    int slot = it->second;
+    if (slot == COMPRESSED_SLOT) {
+        auto compressed = process.compressedPages.find(pageNumber);
+        int frameNum = allocateFrames(process, 0);
+        if (!compressedPool->load(compressed->second, frameBytes(frameNum))) {
+            // 保留池中的对象与表项，页框清零后归还
+            std::cout << "缺页处理失败: 页 " << pageNumber << " 在压缩池中的数据解压出错" << std::endl;
+            memset(frameBytes(frameNum), 0, frameSize * 1024);
+            freeFrames(frameNum, 0);
+            return false;
+        }
+        compressedPool->release(compressed->second);
+        process.compressedPages.erase(compressed);
+        installFrames(process, pageNumber, std::vector<int>(1, frameNum));
+        physicalMemory[frameNum].written = true;
+        process.nonResidentPages.erase(it);
+        compressedFaults++;
+        readahead(process, pageNumber);
+        return true;
+    }
+
+    if (slot == -1) {
+        // 首次访问：分配一个清零的页框
+        int frameNum = allocateFrames(process, 0);
+        installFrames(process, pageNumber, std::vector<int>(1, frameNum));
+        process.nonResidentPages.erase(it);
+        demandZeroFaults++;
+        readahead(process, pageNumber);
+        return true;
+    }
+
+    // 簇读：一次读出包含该槽位的整簇，同进程的相邻页在有空闲页框时一并调入
+    int pageBytes = frameSize * 1024;
+    int firstSlot = slot - slot % swapClusterSize;
+    int count = std::min(swapClusterSize, swapArea->getSlotCount() - firstSlot);
+    ioBuffer.resize((size_t)count * pageBytes);
+    if (!swapArea->readSlots(firstSlot, count, ioBuffer.data())) {
+        return false;
+    }
+
+    if (!installFromSlot(process, pageNumber, slot, &ioBuffer[(size_t)(slot - firstSlot) * pageBytes])) {
+        return false;
+    }
+    // 相邻页与预读一样不动用 min 水位以下的空闲页框
+    for (int i = 0; i < count && availableFrames(process) > minWatermark; i++) {
+        int neighbour = firstSlot + i;
+        int ownerPid;
+        long long ownerPage;
+        if (neighbour == slot || !swapArea->getSlotOwner(neighbour, ownerPid, ownerPage)) continue;
+        if (ownerPid != process.processId) continue;
+
+        auto entry = process.nonResidentPages.find(ownerPage);
+        if (entry == process.nonResidentPages.end() || entry->second != neighbour) continue;
+        if (!installFromSlot(process, ownerPage, neighbour, &ioBuffer[(size_t)i * pageBytes])) continue;
+        PageFrame& neighbourFrame = physicalMemory[lookupPage(process, ownerPage)];
+        neighbourFrame.referenced = false;
+        neighbourFrame.recent = false;
+        clusterReadPages++;
+    }
+    readahead(process, pageNumber);
+    return true;
+}
+
+void PagingMemoryManager::readahead(ProcessInfo& process, long long pageNumber) {
+    // 缺页落在上次预读窗口之后：窗口内的页都用上了，窗口加倍；
+    // 与上次缺页的步长相同：顺序或固定步长访问，保持窗口；否则记下新步长，窗口回到最小
+    bool streaming = true;
+    if (process.readaheadNext != -1 && pageNumber == process.readaheadNext) {
+        process.readaheadWindow = std::min(process.readaheadWindow * 2, readaheadLimit);
+    } else if (process.lastFaultPage == -1 || pageNumber - process.lastFaultPage != process.faultStride) {
+        process.faultStride = process.lastFaultPage == -1 ? 0 : pageNumber - process.lastFaultPage;
+        process.readaheadWindow = READAHEAD_MIN_PAGES;
+        streaming = false;
+    }
+    process.lastFaultPage = pageNumber;
+    process.readaheadNext = -1;
+    if (!streaming || !swapArea || readaheadLimit == 0 || process.faultStride == 0) {
+        return;
+    }
+
+    // 只预读已换出到交换区的页，且不动用 min 水位以下的空闲页框
+    int budget = std::min(std::min(process.readaheadWindow, readaheadLimit),
+                          availableFrames(process) - minWatermark);
+    std::vector<std::pair<int, long long>> batch;  // (交换槽位, 逻辑页号)
+    long long page = pageNumber;
+    for (int i = 0; i < process.readaheadWindow && (int)batch.size() < budget; i++) {
+        page += process.faultStride;
+        auto entry = process.nonResidentPages.find(page);
+        if (entry != process.nonResidentPages.end() && entry->second >= 0) {
+            batch.push_back(std::make_pair(entry->second, page));
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+    process.readaheadNext = page + process.faultStride;
+
+    // 按槽位排序，槽位连续的页一次读出
+    int pageBytes = frameSize * 1024;
+    std::sort(batch.begin(), batch.end());
+    int installed = 0;
+    for (size_t first = 0; first < batch.size();) {
+        size_t last = first + 1;
+        while (last < batch.size() && batch[last].first == batch[last - 1].first + 1) last++;
+        int count = (int)(last - first);
+        ioBuffer.resize((size_t)count * pageBytes);
+        if (!swapArea->readSlots(batch[first].first, count, ioBuffer.data())) {
+            return;
+        }
+        for (size_t i = first; i < last; i++) {
+            if (!installFromSlot(process, batch[i].second, batch[i].first, &ioBuffer[(i - first) * pageBytes])) {
+                continue;
+            }
+            installed++;
+            PageFrame& frame = physicalMemory[lookupPage(process, batch[i].second)];
+            frame.referenced = false;
+            frame.recent = false;
+            frame.prefetched = true;
+        }
+        first = last;
+    }
+    readaheadBatches++;
+    prefetchedPages += installed;
+}
+
+uint64_t PagingMemoryManager::hashFrame(int frameNumber) {
+    // 按 8 字节字做 FNV-1a
+    const char* bytes = frameBytes(frameNumber);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < frameSize * 1024; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool PagingMemoryManager::isZeroFrame(int frameNumber) {
+    const char* bytes = frameBytes(frameNumber);
+    for (int i = 0; i < frameSize * 1024; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        if (word != 0) return false;
+    }
+    return true;
+}
+
+bool PagingMemoryManager::isMovable(int frameNumber) {
+    // 只迁移、合并普通私有页：大页、共享段、已合并和固定的页框除外
+    const PageFrame& frame = physicalMemory[frameNumber];
+    return frame.occupied && frame.shareCount == 0 && !frame.huge && !frame.pinned &&
+           findProcess(frame.processId);
+}
+
+void PagingMemoryManager::makeMerged(int frameNumber) {
+    // 私有页框原地转为只读合并页框，原所有者成为第一个引用者
+    PageFrame& frame = physicalMemory[frameNumber];
+    ProcessInfo* owner = findProcess(frame.processId);
+    unmapPage(*owner, frame.pageNumber, frameNumber);
+    owner->mergedPages[frame.pageNumber] = frameNumber;
+    loadOrder.remove(frameNumber);  // 合并页框与共享页框一样常驻，不再参与置换
+    accessOrder.remove(frameNumber);
+    frame.processId = -1;
+    frame.pageNumber = -1;
+    frame.hashNext = -1;
+    frame.merged = true;
+    frame.shareCount = 1;
+    mergedMappings++;
+}
+
+void PagingMemoryManager::mergeInto(int frameNumber, int target) {
+    const PageFrame& frame = physicalMemory[frameNumber];
+    ProcessInfo* owner = findProcess(frame.processId);
+    long long pageNumber = frame.pageNumber;
+    unmapPage(*owner, pageNumber, frameNumber);
+    owner->mergedPages[pageNumber] = target;
+    physicalMemory[target].shareCount++;
+    mergedMappings++;
+    releaseFrame(frameNumber);
+}
+
+void PagingMemoryManager::dropMergedPage(ProcessInfo& process,
+                                         std::unordered_map<long long, int>::iterator merged) {
+    int frameNumber = merged->second;
+    tlb.invalidate(process.processId, merged->first);
+    process.mergedPages.erase(merged);
+    mergedMappings--;
+    if (--physicalMemory[frameNumber].shareCount > 0) {
+        return;
+    }
+
+    // 最后一个引用者：从合并索引中删除并回收页框
+    if (frameNumber == zeroFrame) {
+        zeroFrame = -1;
+    } else {
+        auto range = stableFrames.equal_range(hashFrame(frameNumber));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == frameNumber) {
+                stableFrames.erase(it);
+                break;
+            }
+        }
+    }
+    releaseFrame(frameNumber);
+}
+
+int PagingMemoryManager::breakCow(ProcessInfo& process, long long pageNumber) {
+    auto merged = process.mergedPages.find(pageNumber);
+    if (availableFrames(process) == 0) {
+        directReclaims++;
+        if (evictPages(swapArea ? swapBatchSize : 1,
+                       process.numaPolicy == NUMA_BIND ? boundNode(process) : -1) == 0) {
+            std::cout << "写时复制失败: 内存不足，没有可用页框" << std::endl;
+            return -1;
+        }
+    }
+
+    // 复制到新的私有页框后再解除引用，合并页框可能随之回收
+    int frameNum = allocateFrames(process, 0);
+    memcpy(frameBytes(frameNum), frameBytes(merged->second), frameSize * 1024);
+    dropMergedPage(process, merged);
+    installFrames(process, pageNumber, std::vector<int>(1, frameNum));
+    cowBreaks++;
+    return frameNum;
+}
+
+// 相同页合并扫描
+int PagingMemoryManager::scanDuplicatePages(int pageCount) {
+    int mergedCount = 0;
+    for (int scanned = 0; scanned < pageCount; scanned++) {
+        int frameNum = scanCursor;
+        scanCursor = (scanCursor + 1) % totalFrames;
+        if (scanCursor == 0) {
+            unstableFrames.clear();  // 一轮结束，候选页的内容可能已经改变
+        }
+        // 从未写过的页必是全零，合并后第一次写入就要写时复制，留给进程自己使用
+        if (!isMovable(frameNum) || !physicalMemory[frameNum].written) continue;
+        pagesScanned++;
+
+        // 全零页合并到同一个零页框
+        if (isZeroFrame(frameNum)) {
+            if (zeroFrame == -1) {
+                makeMerged(frameNum);
+                zeroFrame = frameNum;
+            } else {
+                mergeInto(frameNum, zeroFrame);
+                zeroPagesMerged++;
+                mergedCount++;
+            }
+            continue;
+        }
+
+        // 先找已合并的页框，散列相同时逐字节确认
+        uint64_t hash = hashFrame(frameNum);
+        int target = -1;
+        auto range = stableFrames.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (memcmp(frameBytes(it->second), frameBytes(frameNum), frameSize * 1024) == 0) {
+                target = it->second;
+                break;
+            }
+        }
+
+        // 再找本轮见过的私有页，相同则将其转为合并页框
+        if (target == -1) {
+            auto candidate = unstableFrames.find(hash);
+            if (candidate == unstableFrames.end() || candidate->second == frameNum ||
+                !isMovable(candidate->second) ||
+                memcmp(frameBytes(candidate->second), frameBytes(frameNum), frameSize * 1024) != 0) {
+                unstableFrames[hash] = frameNum;
+                continue;
+            }
+            target = candidate->second;
+            unstableFrames.erase(candidate);
+            makeMerged(target);
+            stableFrames.emplace(hash, target);
+        }
+
+        mergeInto(frameNum, target);
+        mergedCount++;
+    }
+    return mergedCount;
+}
+
+long long PagingMemoryManager::getFramesSaved() {
+    long long mergedFrames = (long long)stableFrames.size() + (zeroFrame != -1 ? 1 : 0);
+    return mergedMappings - mergedFrames;
+}
+
+void PagingMemoryManager::showDedupStatus() {
+    std::cout << "相同页合并: 扫描 " << pagesScanned << " 页, " << mergedMappings << " 个逻辑页共用 "
+              << stableFrames.size() + (zeroFrame != -1 ? 1 : 0) << " 个页框 (零页合并 "
+              << zeroPagesMerged << " 次), 节省 " << getFramesSaved() << " 个页框, 写时复制 "
+              << cowBreaks << " 次" << std::endl;
+}
+
+void PagingMemoryManager::resetCompactionCursors() {
+    int nodes = (int)nodeAllocators.size();
+    migrateCursor.assign(nodes, 0);
+    freeCursor.assign(nodes, 0);
+    for (int node = 0; node < nodes; node++) {
+        migrateCursor[node] = node * framesPerNode;
+        freeCursor[node] = node == nodes - 1 ? totalFrames - 1 : (node + 1) * framesPerNode - 1;
+    }
+}
+
+void PagingMemoryManager::migrateFrame(int from, int to) {
+    // 经页框的反向映射找到所有者，改写其页表项
+    const PageFrame& frame = physicalMemory[from];
+    ProcessInfo* owner = findProcess(frame.processId);
+    long long pageNumber = frame.pageNumber;
+    unmapPage(*owner, pageNumber, from);
+    moveFrame(from, to);
+    mapPage(*owner, pageNumber, to);
+    pagesMigrated++;
+}
+
+// 请求规整
+void PagingMemoryManager::requestCompaction(int order, int node) {
+    if (node < 0 || node >= (int)nodeAllocators.size() || order > nodeAllocators[node].getMaxOrder()) {
+        return;
+    }
+    if (compactionOrder == -1 || node != compactionNode) {
+        compactionNode = node;
+        compactionOrder = order;
+        compactionRequests++;
+    } else {
+        compactionOrder = std::max(compactionOrder, order);
+    }
+}
+
+// 执行一步规整
+int PagingMemoryManager::compactMemory(int maxPages) {
+    if (compactionOrder == -1) {
+        return 0;
+    }
+
+    int node = compactionNode;
+    BuddyAllocator& pool = nodeAllocators[node];
+    int& low = migrateCursor[node];
+    int& high = freeCursor[node];
+    int migrated = 0;
+    while (migrated < maxPages && pool.getLargestFreeOrder() < compactionOrder) {
+        while (low < high && !isMovable(low)) low++;
+        while (high > low && !pool.isFree(high)) high--;
+        if (low >= high) break;  // 两个扫描相遇，本轮已无可做
+
+        pool.claim(high);
+        migrateFrame(low, high);
+        low++;
+        high--;
+        migrated++;
+    }
+
+    bool satisfied = pool.getLargestFreeOrder() >= compactionOrder;
+    if (satisfied || low >= high) {
+        std::cout << "内存规整" << (satisfied ? "完成" : "结束") << ": 节点 " << node << " 最大空闲块 "
+                  << (1 << std::max(0, pool.getLargestFreeOrder())) << " 页，累计迁移 "
+                  << pagesMigrated << " 页" << std::endl;
+        compactionOrder = -1;
+        resetCompactionCursors();
+    }
+    return migrated;
+}
+
+void PagingMemoryManager::releaseFrame(int frameNumber) {
+    PageFrame& frame = physicalMemory[frameNumber];
+    frame.occupied = false;
+    frame.processId = -1;
+    frame.pageNumber = -1;
+    frame.hashNext = -1;
+    frame.referenced = false;
+    frame.dirty = false;
+    frame.huge = false;
+    frame.shareCount = 0;
+    frame.merged = false;
+    frame.pinned = false;
+    if (frame.prefetched) {
+        prefetchWasted++;
+        frame.prefetched = false;
+    }
+    frame.age = 0;
+    frame.recent = false;
+    frame.written = false;
+    loadOrder.remove(frameNumber);
+    accessOrder.remove(frameNumber);
+    memset(frameBytes(frameNumber), 0, frameSize * 1024);  // 空闲页框保持全零，分配时无需再清零
+    freeFrames(frameNumber, 0);
+}
+
+void PagingMemoryManager::moveFrame(int from, int to) {
+    // 目标页框已由调用者从伙伴系统取得，源页框的映射已解除
+    physicalMemory[to] = physicalMemory[from];
+    physicalMemory[to].hashNext = -1;
+    loadOrder.replace(from, to);  // 迁移不改变页的调入与访问顺序
+    accessOrder.replace(from, to);
+    memcpy(frameBytes(to), frameBytes(from), frameSize * 1024);
+    physicalMemory[from].prefetched = false;  // 预取标记已随页移到目标页框，源页框释放不算预取浪费
+    releaseFrame(from);
+}
+
+bool PagingMemoryManager::promoteRegion(ProcessInfo& process, long long hugeNumber) {
+    int pages = 1 << hugePageOrder;
+    long long firstPage = hugeNumber << hugePageOrder;
+    std::vector<int> frames(pages);
+    for (int i = 0; i < pages; i++) {
+        frames[i] = lookupPage(process, firstPage + i);
+        if (frames[i] == -1 || physicalMemory[frames[i]].huge || physicalMemory[frames[i]].shareCount > 0 ||
+            physicalMemory[frames[i]].pinned) {
+            return false;
+        }
+    }
+
+    // 页框已是对齐的连续段时原地提升，否则迁移到新取得的整块
+    bool inPlace = frames[0] % pages == 0;
+    for (int i = 1; i < pages && inPlace; i++) {
+        inPlace = frames[i] == frames[0] + i;
+    }
+    int baseFrame = inPlace ? frames[0] : allocateFrames(process, hugePageOrder);
+    if (baseFrame == -1) {
+        requestCompaction(hugePageOrder, process.homeNode);
+        return false;
+    }
+
+    for (int i = 0; i < pages; i++) {
+        unmapPage(process, firstPage + i, frames[i]);
+        if (!inPlace) {
+            moveFrame(frames[i], baseFrame + i);
+        }
+        physicalMemory[baseFrame + i].huge = true;
+    }
+    process.hugePages[hugeNumber] = baseFrame;
+    hugePromotions++;
+    return true;
+}
+
+void PagingMemoryManager::demoteHugePage(ProcessInfo& process, long long hugeNumber) {
+    auto it = process.hugePages.find(hugeNumber);
+    if (it == process.hugePages.end()) return;
+
+    int baseFrame = it->second;
+    long long firstPage = hugeNumber << hugePageOrder;
+    process.hugePages.erase(it);
+    tlb.invalidate(process.processId, firstPage);
+
+    // 拆成 2^hugePageOrder 个基本页表项，页框不动
+    for (int i = 0; i < (1 << hugePageOrder); i++) {
+        physicalMemory[baseFrame + i].huge = false;
+        mapPage(process, firstPage + i, baseFrame + i);
+    }
+    hugeDemotions++;
+}
+
+// 启用大页
+bool PagingMemoryManager::enableHugePages(int order) {
+    int maxOrder = nodeAllocators[0].getMaxOrder();
+    for (const BuddyAllocator& node : nodeAllocators) {
+        maxOrder = std::min(maxOrder, node.getMaxOrder());
+    }
+    if (order < 1 || order > maxOrder) {
+        std::cout << "大页启用失败: 阶数 " << order << " 无效" << std::endl;
+        return false;
+    }
+
+    // 改变大页大小前先拆分已有的大页
+    for (auto& slot : processTable) {
+        if (!slot || slot->processId == -1) continue;
+        while (!slot->hugePages.empty()) {
+            demoteHugePage(*slot, slot->hugePages.begin()->first);
         }
-    };
-    
-    int totalFrames;                    // 总页框数
-    int frameSize;                      // 页框大小(KB)
-    std::vector<PageFrame> physicalMemory;  // 物理内存页框
-    std::queue<int> freeFrames;         // 空闲页框队列
-    std::map<int, ProcessInfo> processes;   // 进程信息表
-    
-public:
-    PagingMemoryManager(int frames, int size) : totalFrames(frames), frameSize(size) {
-        physicalMemory.resize(totalFrames);
-        // 初始化所有页框为空闲
-        for (int i = 0; i < totalFrames; i++) {
-            freeFrames.push(i);
-        }
-        
-        std::cout << "分页式存储管理系统初始化完成" << std::endl;
-        std::cout << "总页框数: " << totalFrames << std::endl;
-        std::cout << "页框大小: " << frameSize << "KB" << std::endl;
-        std::cout << "总内存大小: " << totalFrames * frameSize << "KB" << std::endl;
-        std::cout << "----------------------------------------" << std::endl;
-    }
-    
-    // 为进程分配内存
-    bool allocateMemory(int processId, int memorySize) {
-        // 计算需要的页数
-        int pagesNeeded = (memorySize + frameSize - 1) / frameSize;  // 向上取整
-        
-        if (pagesNeeded > freeFrames.size()) {
-            std::cout << "内存分配失败: 进程 " << processId 
-                      << " 需要 " << pagesNeeded << " 页，但只有 " 
-                      << freeFrames.size() << " 页可用" << std::endl;
-            return false;
+    }
+    hugePageOrder = order;
+    tlb.setHugeOrder(order);
+
+    std::cout << "大页已启用: " << (1 << order) * frameSize << "KB ("
+              << (1 << order) << " 个页框)" << std::endl;
+    return true;
+}
+
+// 大页提升
+int PagingMemoryManager::promoteHugePages(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || hugePageOrder == 0) {
+        return 0;
+    }
+
+    // 统计每个对齐区域内驻留的基本页数，填满的区域才提升：区域号排序后相同的连成一段，段长即页数
+    hugeRegions.clear();
+    forEachMapping(*process, [&](long long page, int frameNum) {
+        if (!physicalMemory[frameNum].huge) {
+            hugeRegions.push_back(page >> hugePageOrder);
         }
-        
-        // 检查进程是否已存在
-        if (processes.find(processId) != processes.end()) {
-            std::cout << "内存分配失败: 进程 " << processId << " 已存在" << std::endl;
-            return false;
+    });
+    std::sort(hugeRegions.begin(), hugeRegions.end());
+
+    int promoted = 0;
+    for (size_t i = 0; i < hugeRegions.size();) {
+        size_t end = i;
+        while (end < hugeRegions.size() && hugeRegions[end] == hugeRegions[i]) end++;
+        if (end - i == (size_t)1 << hugePageOrder && promoteRegion(*process, hugeRegions[i])) {
+            promoted++;
         }
-        
-        // 创建进程信息
-        ProcessInfo process(processId, pagesNeeded);
-        
-        // 分配页框
-        std::vector<int> allocatedFrames;
-        for (int i = 0; i < pagesNeeded; i++) {
-            int frameNum = freeFrames.front();
-            freeFrames.pop();
-            allocatedFrames.push_back(frameNum);
-            
-            // 更新页框信息
-            physicalMemory[frameNum].occupied = true;
-            physicalMemory[frameNum].processId = processId;
-            physicalMemory[frameNum].pageNumber = i;
-            
-            // 更新页表
-            process.pageTable[i] = frameNum;
-        }
-        
-        // 保存进程信息
-        processes[processId] = process;
-        
-        std::cout << "内存分配成功: 进程 " << processId 
-                  << " 分配了 " << pagesNeeded << " 页 (" 
-                  << memorySize << "KB)" << std::endl;
-        std::cout << "分配的页框: ";
-        for (int frame : allocatedFrames) {
-            std::cout << frame << " ";
+        i = end;
+    }
+    return promoted;
+}
+
+int PagingMemoryManager::scanHugePages() {
+    int promoted = 0;
+    for (auto& slot : processTable) {
+        if (slot && slot->processId != -1 && !slot->swappedOut) {
+            promoted += promoteHugePages(slot->processId);
         }
-        std::cout << std::endl;
-        
-        return true;
     }
-    
-    // 回收进程内存
-    bool deallocateMemory(int processId) {
-        auto it = processes.find(processId);
-        if (it == processes.end()) {
-            std::cout << "内存回收失败: 进程 " << processId << " 不存在" << std::endl;
+    return promoted;
+}
+
+// 配置 NUMA 拓扑
+bool PagingMemoryManager::configureNuma(int nodeCount, int cpus,
+                                        const std::vector<std::vector<int>>& distances) {
+    if (processCount > 0 || nodeCount < 1 || nodeCount > totalFrames || cpus < 1) {
+        std::cout << "NUMA 配置失败: 已有进程或参数无效" << std::endl;
+        return false;
+    }
+    if (!distances.empty()) {
+        bool valid = (int)distances.size() == nodeCount;
+        for (int i = 0; valid && i < nodeCount; i++) {
+            valid = (int)distances[i].size() == nodeCount && distances[i][i] == LOCAL_DISTANCE;
+        }
+        if (!valid) {
+            std::cout << "NUMA 配置失败: 距离矩阵应为 " << nodeCount << "x" << nodeCount
+                      << " 且对角线为 " << LOCAL_DISTANCE << std::endl;
             return false;
         }
-        
-        ProcessInfo& process = it->second;
-        std::vector<int> freedFrames;
-        int pageCount = process.pageCount;  // 保存页数，因为后面会删除进程信息
-        
-        // 释放所有页框
-        for (int i = 0; i < process.pageCount; i++) {
-            int frameNum = process.pageTable[i];
-            if (frameNum != -1) {
-                // 重置页框信息
-                physicalMemory[frameNum].occupied = false;
-                physicalMemory[frameNum].processId = -1;
-                physicalMemory[frameNum].pageNumber = -1;
-                
-                // 添加到空闲队列
-                freeFrames.push(frameNum);
-                freedFrames.push_back(frameNum);
-            }
+    }
+
+    framesPerNode = totalFrames / nodeCount;
+    cpusPerNode = cpus;
+    nodeAllocators.clear();
+    for (int node = 0; node < nodeCount; node++) {
+        int first = node * framesPerNode;
+        int count = node == nodeCount - 1 ? totalFrames - first : framesPerNode;
+        nodeAllocators.push_back(BuddyAllocator(first, count));
+    }
+
+    if (distances.empty()) {
+        nodeDistance.assign(nodeCount, std::vector<int>(nodeCount, REMOTE_DISTANCE));
+        for (int node = 0; node < nodeCount; node++) {
+            nodeDistance[node][node] = LOCAL_DISTANCE;
         }
-        
-        // 删除进程信息
-        processes.erase(it);
-        
-        std::cout << "内存回收成功: 进程 " << processId 
-                  << " 释放了 " << pageCount << " 页" << std::endl;
-        std::cout << "释放的页框: ";
-        for (int frame : freedFrames) {
-            std::cout << frame << " ";
+    } else {
+        nodeDistance = distances;
+    }
+
+    compactionOrder = -1;
+    resetCompactionCursors();
+
+    // 预先算好每个节点的回退顺序
+    nodeFallback.assign(nodeCount, std::vector<int>());
+    for (int node = 0; node < nodeCount; node++) {
+        for (int other = 0; other < nodeCount; other++) {
+            nodeFallback[node].push_back(other);
         }
-        std::cout << std::endl;
-        
-        return true;
+        const std::vector<int>& row = nodeDistance[node];
+        std::stable_sort(nodeFallback[node].begin(), nodeFallback[node].end(),
+                         [&row](int a, int b) { return row[a] < row[b]; });
     }
-    
-    // 逻辑地址转换为物理地址
-    int translateAddress(int processId, int logicalAddress) {
-        auto it = processes.find(processId);
-        if (it == processes.end()) {
-            std::cout << "地址转换失败: 进程 " << processId << " 不存在" << std::endl;
-            return -1;
+
+    std::cout << "NUMA 拓扑: " << nodeCount << " 个节点，每节点 " << framesPerNode
+              << " 个页框、" << cpusPerNode << " 个 CPU" << std::endl;
+    return true;
+}
+
+void PagingMemoryManager::setDefaultNumaPolicy(NumaPolicy policy) {
+    defaultNumaPolicy = policy;
+}
+
+bool PagingMemoryManager::setNumaPolicy(int processId, NumaPolicy policy, int node) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || node < -1 || node >= (int)nodeAllocators.size() || (policy == NUMA_BIND && node == -1)) {
+        return false;
+    }
+    process->numaPolicy = policy;
+    process->bindNode = node;
+    return true;
+}
+
+bool PagingMemoryManager::setProcessCpu(int processId, int cpu) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || cpu < 0) {
+        return false;
+    }
+    process->homeNode = cpu / cpusPerNode % (int)nodeAllocators.size();
+    return true;
+}
+
+int PagingMemoryManager::getNodeCount() {
+    return (int)nodeAllocators.size();
+}
+
+long long PagingMemoryManager::getRemoteAccesses() {
+    return remoteAccessCount;
+}
+
+void PagingMemoryManager::showNumaStatus() {
+    static const char* policyNames[] = {"本地优先", "交错", "绑定"};
+    int nodes = (int)nodeAllocators.size();
+
+    std::cout << "NUMA 节点:" << std::endl;
+    for (int node = 0; node < nodes; node++) {
+        std::cout << "  节点 " << node << ": 空闲 " << nodeAllocators[node].getFreeCount()
+                  << " 页, 距离";
+        for (int other = 0; other < nodes; other++) {
+            std::cout << " " << nodeDistance[node][other];
         }
-        
-        ProcessInfo& process = it->second;
-        
-        // 计算页号和页内偏移
-        int pageNumber = logicalAddress / (frameSize * 1024);  // 转换为字节
-        int offset = logicalAddress % (frameSize * 1024);
-        
-        if (pageNumber >= process.pageCount) {
-            std::cout << "地址转换失败: 页号 " << pageNumber << " 超出范围" << std::endl;
-            return -1;
+        std::cout << std::endl;
+    }
+    for (auto& slot : processTable) {
+        if (!slot || slot->processId == -1) continue;
+        const ProcessInfo& process = *slot;
+        std::vector<int> residentPerNode(nodes, 0);
+        forEachMapping(process, [&](long long, int frameNum) {
+            residentPerNode[nodeOf(frameNum)]++;
+        });
+        std::cout << "  进程 " << process.processId << ": 本地节点 " << process.homeNode
+                  << ", " << policyNames[process.numaPolicy] << ", 各节点驻留页";
+        for (int count : residentPerNode) {
+            std::cout << " " << count;
         }
-        
-        int frameNumber = process.pageTable[pageNumber];
-        if (frameNumber == -1) {
-            std::cout << "地址转换失败: 页 " << pageNumber << " 未分配" << std::endl;
-            return -1;
+        std::cout << ", 远端访问 " << process.remoteAccesses << "/"
+                  << process.localAccesses + process.remoteAccesses << std::endl;
+    }
+
+    long long accesses = localAccessCount + remoteAccessCount;
+    long long localNanos = accesses * LOCAL_LATENCY_NS;
+    std::cout << "远端访问: " << remoteAccessCount << "/" << accesses << " 次, 平均延迟 "
+              << std::fixed << std::setprecision(1)
+              << (accesses ? (double)accessLatencyNanos / accesses : 0.0) << "ns, 远端额外延迟 "
+              << (accessLatencyNanos - localNanos) / 1000.0 << "us" << std::endl;
+}
+
+void PagingMemoryManager::setTlbEntries(int entries) {
+    tlb.setCapacity(std::max(0, entries));
+}
+
+void PagingMemoryManager::showTlbStatus() {
+    tlb.showStatus(frameSize * 1024);
+    if (hugePageOrder > 0) {
+        std::cout << "大页: " << (1 << hugePageOrder) * frameSize << "KB, 提升 " << hugePromotions
+                  << " 次, 拆分 " << hugeDemotions << " 次" << std::endl;
+    }
+}
+
+// 显示内存状态
+void PagingMemoryManager::displayMemoryStatus() {
+    std::cout << "\n======== 内存状态 ========" << std::endl;
+
+    // 显示页框使用情况
+    std::cout << "页框使用情况:" << std::endl;
+    std::cout << "页框号\t状态\t进程ID\t逻辑页号" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    for (int i = 0; i < totalFrames; i++) {
+        std::cout << std::setw(4) << i << "\t";
+        if (physicalMemory[i].occupied && physicalMemory[i].merged) {
+            std::cout << (i == zeroFrame ? "零页\t" : "合并\t") << physicalMemory[i].shareCount << "个\t-";
+        } else if (physicalMemory[i].occupied && physicalMemory[i].shareCount > 0) {
+            std::cout << "共享\t" << physicalMemory[i].shareCount << "个\t段内" << physicalMemory[i].pageNumber;
+        } else if (physicalMemory[i].occupied) {
+            std::cout << (physicalMemory[i].huge ? "大页\t" : "占用\t") << physicalMemory[i].processId
+                      << "\t" << physicalMemory[i].pageNumber;
+        } else {
+            std::cout << "空闲\t-\t-";
         }
-        
-        int physicalAddress = frameNumber * frameSize * 1024 + offset;
-        
-        std::cout << "地址转换: 进程 " << processId 
-                  << " 逻辑地址 " << logicalAddress 
-                  << " -> 物理地址 " << physicalAddress 
-                  << " (页号:" << pageNumber << ", 页框:" << frameNumber 
-                  << ", 偏移:" << offset << ")" << std::endl;
-        
-        return physicalAddress;
-    }
-    
-    // 显示内存状态
-    void displayMemoryStatus() {
-        std::cout << "\n======== 内存状态 ========" << std::endl;
-        
-        // 显示页框使用情况
-        std::cout << "页框使用情况:" << std::endl;
-        std::cout << "页框号\t状态\t进程ID\t逻辑页号" << std::endl;
-        std::cout << "------------------------------------" << std::endl;
-        
-        for (int i = 0; i < totalFrames; i++) {
-            std::cout << std::setw(4) << i << "\t";
-            if (physicalMemory[i].occupied) {
-                std::cout << "占用\t" << physicalMemory[i].processId 
-                          << "\t" << physicalMemory[i].pageNumber;
-            } else {
-                std::cout << "空闲\t-\t-";
+        std::cout << std::endl;
+    }
+
+    // 显示进程信息
+    std::cout << "\n进程信息:" << std::endl;
+    std::cout << "进程ID\t页数\t工作集\t页表(B)\t页表映射" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    for (auto& slot : processTable) {
+        if (!slot || slot->processId == -1) continue;
+        ProcessInfo& process = *slot;
+        std::cout << process.processId << "\t" << process.pageCount << "\t"
+                  << workingSetOf(process) << "\t" << pageTableMemory(process) << "\t";
+        forEachMapping(process, [](long long page, int frame) {
+            std::cout << page << "->" << frame << " ";
+        });
+        std::cout << std::endl;
+    }
+
+    if (!sharedSegments.empty()) {
+        std::cout << "\n共享段:" << std::endl;
+        for (auto& pair : sharedSegments) {
+            std::cout << "段 " << pair.first << ": " << pair.second.frames.size() << " 页, 挂接 "
+                      << pair.second.attachCount << " 次, 页框";
+            for (int frameNum : pair.second.frames) {
+                std::cout << " " << frameNum;
             }
             std::cout << std::endl;
         }
-        
-        // 显示进程信息
-        std::cout << "\n进程信息:" << std::endl;
-        std::cout << "进程ID\t页数\t页表映射" << std::endl;
-        std::cout << "------------------------------------" << std::endl;
-        
-        for (auto& pair : processes) {
-            ProcessInfo& process = pair.second;
-            std::cout << process.processId << "\t" << process.pageCount << "\t";
-            for (int i = 0; i < process.pageCount; i++) {
-                std::cout << i << "->" << process.pageTable[i] << " ";
-            }
-            std::cout << std::endl;
+    }
+
+    // 显示内存利用率
+    int occupiedFrames = totalFrames - freeFrameCount();
+    double utilization = (double)occupiedFrames / totalFrames * 100;
+    std::cout << "\n内存利用率: " << std::fixed << std::setprecision(2)
+              << utilization << "% (" << occupiedFrames << "/"
+              << totalFrames << ")" << std::endl;
+    std::cout << "空闲页框数: " << freeFrameCount() << std::endl;
+    if (nodeAllocators.size() > 1) {
+        showNumaStatus();
+    } else {
+        nodeAllocators[0].showStatus();
+    }
+    std::cout << "页表总占用: " << getTotalPageTableMemory() << " 字节" << std::endl;
+    std::cout << "工作集总和: " << getTotalWorkingSet() << "/" << totalFrames
+              << (isThrashing() ? " (抖动)" : "") << std::endl;
+    showTlbStatus();
+    if (pagesScanned > 0) {
+        showDedupStatus();
+    }
+    if (compactionRequests > 0) {
+        std::cout << "内存规整: 请求 " << compactionRequests << " 次, 迁移 " << pagesMigrated << " 页"
+                  << (compactionOrder != -1 ? " (进行中)" : "") << std::endl;
+    }
+    if (swapArea) {
+        showSwapStatus();
+    }
+    std::cout << "================================\n" << std::endl;
+}
+
+// 获取内存利用率
+void PagingMemoryManager::setVerbose(bool enabled) {
+    verbose = enabled;
+}
+
+double PagingMemoryManager::getMemoryUtilization() {
+    int occupiedFrames = totalFrames - freeFrameCount();
+    return (double)occupiedFrames / totalFrames * 100;
+}
+
+// 获取空闲内存大小
+int PagingMemoryManager::getFreeMemory() {
+    return freeFrameCount() * frameSize;
+}
+
+// 获取外部碎片率
+double PagingMemoryManager::getFragmentation() {
+    // 各节点的伙伴系统互不合并，最大空闲块取所有节点中的最大者
+    int freeCount = freeFrameCount();
+    int largestBlock = 0;
+    for (const BuddyAllocator& node : nodeAllocators) {
+        int order = node.getLargestFreeOrder();
+        if (order >= 0) largestBlock = std::max(largestBlock, 1 << order);
+    }
+    return freeCount ? 1.0 - (double)largestBlock / freeCount : 0.0;
+}
+
+// 获取进程页表占用的内存
+size_t PagingMemoryManager::getPageTableMemory(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    return process ? pageTableMemory(*process) : 0;
+}
+
+// 设置工作集窗口
+void PagingMemoryManager::setWorkingSetWindow(int window) {
+    workingSetWindow = std::max(1, window);
+}
+
+// 获取进程工作集大小
+int PagingMemoryManager::getWorkingSetSize(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    return process ? workingSetOf(*process) : 0;
+}
+
+// 获取所有进程工作集之和
+int PagingMemoryManager::getTotalWorkingSet() {
+    int total = 0;
+    for (auto& slot : processTable) {
+        if (slot && slot->processId != -1 && !slot->swappedOut) {
+            total += workingSetOf(*slot);
+        }
+    }
+    for (auto& pair : sharedSegments) {
+        total += (int)pair.second.frames.size();
+    }
+    total += (int)stableFrames.size() + (zeroFrame != -1 ? 1 : 0);
+    return total;
+}
+
+// 是否处于抖动状态
+bool PagingMemoryManager::isThrashing() {
+    return getTotalWorkingSet() > totalFrames;
+}
+
+// 接纳控制
+bool PagingMemoryManager::canAdmit(int memorySize) {
+    int pagesNeeded = (memorySize + frameSize - 1) / frameSize;
+    return getTotalWorkingSet() + reservedPages + pagesNeeded <= totalFrames;
+}
+
+bool PagingMemoryManager::isAdmissible(int processId, int memorySize) {
+    if (processId < 0 || processId > MAX_PROCESS_ID || memorySize < 0 ||
+        findProcess(processId) || reservations.count(processId)) {
+        return false;
+    }
+    long long pagesNeeded = (memorySize + frameSize - 1) / frameSize;
+    return pagesNeeded <= totalFrames && pagesNeeded <= commitLimit();
+}
+
+int PagingMemoryManager::getTotalFrames() {
+    return totalFrames;
+}
+
+// 启用交换区
+bool PagingMemoryManager::enableSwap(const std::string& path, int slotCount, int batchSize, int clusterSize) {
+    std::unique_ptr<SwapArea> area(new SwapArea(path, slotCount, frameSize * 1024));
+    if (!area->isOpen()) {
+        return false;
+    }
+    swapArea = std::move(area);
+    swapBatchSize = std::max(1, batchSize);
+    swapClusterSize = std::max(1, clusterSize);
+    return true;
+}
+
+bool PagingMemoryManager::enableCompressedSwap(int poolKB) {
+    if (!swapArea || poolKB <= 0) {
+        std::cout << "压缩交换层启用失败: 需要先启用交换区" << std::endl;
+        return false;
+    }
+    compressedPool.reset(new CompressedPool(frameSize * 1024, poolKB * 1024));
+    std::cout << "压缩交换层已启用: 池大小 " << poolKB << "KB" << std::endl;
+    return true;
+}
+
+bool PagingMemoryManager::isSwapEnabled() {
+    return swapArea != nullptr;
+}
+
+// 换出进程的全部驻留页
+int PagingMemoryManager::swapOutProcess(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    if (!process || !swapArea) {
+        return 0;
+    }
+
+    // 固定的页框（物理地址交给了设备）与共享页框常驻内存，不随进程换出
+    std::vector<int> frames;
+    forEachMapping(*process, [&](long long, int frameNum) {
+        if (!physicalMemory[frameNum].pinned && physicalMemory[frameNum].shareCount == 0) {
+            frames.push_back(frameNum);
+        }
+    });
+
+    int swapped = 0;
+    for (size_t i = 0; i < frames.size(); i += swapBatchSize) {
+        std::vector<int> batch(frames.begin() + i,
+                               frames.begin() + std::min(frames.size(), i + swapBatchSize));
+        swapped += swapOutFrames(batch);
+    }
+    process->swappedOut = true;
+
+    std::cout << "进程 " << processId << " 已换出 " << swapped << " 页" << std::endl;
+    return swapped;
+}
+
+void PagingMemoryManager::resumeProcess(int processId) {
+    ProcessInfo* process = findProcess(processId);
+    if (process) {
+        process->swappedOut = false;
+    }
+}
+
+void PagingMemoryManager::setReplacementPolicy(ReplacementPolicy policy) {
+    replacementPolicy = policy;
+}
+
+long long PagingMemoryManager::getPageFaults() {
+    return pageFaultCount;
+}
+
+long long PagingMemoryManager::getCompressedFaults() {
+    return compressedFaults;
+}
+
+bool PagingMemoryManager::setWatermarks(int minFrames, int lowFrames, int highFrames) {
+    if (minFrames < 1 || minFrames > lowFrames || lowFrames > highFrames || highFrames >= totalFrames) {
+        std::cout << "水位设置失败: 需要 0 < min <= low <= high < " << totalFrames << std::endl;
+        return false;
+    }
+    minWatermark = minFrames;
+    lowWatermark = lowFrames;
+    highWatermark = highFrames;
+    return true;
+}
+
+// 后台回收
+int PagingMemoryManager::reclaimPages(int maxPages) {
+    if (!swapArea) {
+        return 0;
+    }
+
+    agePages();
+    if (!reclaimActive) {
+        if (freeFrameCount() >= lowWatermark) {
+            return 0;
+        }
+        reclaimActive = true;
+        reclaimWakeups++;
+    }
+
+    int reclaimed = 0;
+    std::vector<int> victims;
+    while (reclaimed < maxPages && freeFrameCount() < highWatermark) {
+        int batch = std::min(swapBatchSize, std::min(maxPages - reclaimed, highWatermark - freeFrameCount()));
+        selectColdVictims(batch, victims);
+        int swapped = swapOutFrames(victims);
+        if (swapped == 0) {
+            break;  // 没有可换出的页或交换区已满
+        }
+        reclaimed += swapped;
+    }
+    reclaimedPages += reclaimed;
+    if (freeFrameCount() >= highWatermark) {
+        reclaimActive = false;
+    }
+    return reclaimed;
+}
+
+void PagingMemoryManager::setReadaheadLimit(int pages) {
+    readaheadLimit = std::max(0, pages);
+}
+
+void PagingMemoryManager::showSwapStatus() {
+    std::cout << "缺页: " << pageFaultCount << " 次 (首次访问填零 " << demandZeroFaults
+              << " 次, 簇读带入相邻页 " << clusterReadPages << " 页)" << std::endl;
+    if (swapArea) {
+        std::cout << "后台回收: 水位 min/low/high = " << minWatermark << "/" << lowWatermark << "/"
+                  << highWatermark << ", 唤醒 " << reclaimWakeups << " 次, 换出 " << reclaimedPages
+                  << " 页; 缺页同步换出 " << directReclaims << " 次" << std::endl;
+        std::cout << "预读: " << readaheadBatches << " 次共 " << prefetchedPages << " 页, 命中 "
+                  << prefetchHits << " 页, 浪费 " << prefetchWasted << " 页, 准确率 " << std::fixed
+                  << std::setprecision(2)
+                  << (prefetchedPages ? 100.0 * prefetchHits / prefetchedPages : 0.0) << "%" << std::endl;
+        if (compressedPool) {
+            std::cout << "压缩层: 压缩换出 " << compressedOut << " 页, 解压换入 " << compressedFaults
+                      << " 次, 冷页写回交换区 " << compressedWriteback << " 页" << std::endl;
+            compressedPool->showStatus();
+        }
+        swapArea->showStatus();
+    }
+}
+
+// 获取所有页表占用的内存
+size_t PagingMemoryManager::getTotalPageTableMemory() {
+    if (pageTableType == INVERTED_PAGE_TABLE) {
+        return hashAnchor.size() * sizeof(int) + physicalMemory.size() * sizeof(int);
+    }
+    size_t total = 0;
+    for (auto& slot : processTable) {
+        if (slot && slot->processId != -1) {
+            total += pageTableMemory(*slot);
         }
-        
-        // 显示内存利用率
-        int occupiedFrames = totalFrames - freeFrames.size();
-        double utilization = (double)occupiedFrames / totalFrames * 100;
-        std::cout << "\n内存利用率: " << std::fixed << std::setprecision(2) 
-                  << utilization << "% (" << occupiedFrames << "/" 
-                  << totalFrames << ")" << std::endl;
-        std::cout << "空闲页框数: " << freeFrames.size() << std::endl;
-        std::cout << "================================\n" << std::endl;
-    }
-    
-    // 获取内存利用率
-    double getMemoryUtilization() {
-        int occupiedFrames = totalFrames - freeFrames.size();
-        return (double)occupiedFrames / totalFrames * 100;
-    }
-    
-    // 获取空闲内存大小
-    int getFreeMemory() {
-        return freeFrames.size() * frameSize;
-    }
-};
+    }
+    return total;
+}
+
+// 反向查找页框的所有者
+bool PagingMemoryManager::getFrameOwner(int frameNumber, int& processId, long long& pageNumber) {
+    if (frameNumber < 0 || frameNumber >= totalFrames || !physicalMemory[frameNumber].occupied) {
+        return false;
+    }
+    processId = physicalMemory[frameNumber].processId;
+    pageNumber = physicalMemory[frameNumber].pageNumber;
+    return true;
+}
 
 // 测试函数
 void runPageManagerDemo(){
     std::cout << "=== 分页式存储管理系统演示 ===" << std::endl;
-    
+
     // 创建管理器：16个页框，每个4KB
     PagingMemoryManager manager(16, 4);
-    
+
     std::cout << "\n1. 分配内存测试:" << std::endl;
     manager.allocateMemory(101, 12);  // 进程101需要12KB（3页）
     manager.allocateMemory(102, 20);  // 进程102需要20KB（5页）
     manager.allocateMemory(103, 8);   // 进程103需要8KB（2页）
-    
+
     manager.displayMemoryStatus();
-    
+
     std::cout << "2. 地址转换测试:" << std::endl;
     manager.translateAddress(101, 5000);   // 进程101的逻辑地址5000
     manager.translateAddress(102, 10000);  // 进程102的逻辑地址10000
     manager.translateAddress(103, 2000);   // 进程103的逻辑地址2000
-    
+
     std::cout << "\n3. 内存回收测试:" << std::endl;
     manager.deallocateMemory(102);  // 回收进程102
-    
+
     manager.displayMemoryStatus();
-    
+
     std::cout << "4. 再次分配测试:" << std::endl;
     manager.allocateMemory(104, 16);  // 进程104需要16KB（4页）
-    
+
     manager.displayMemoryStatus();
-    
+
     std::cout << "5. 尝试分配过大内存:" << std::endl;
     manager.allocateMemory(105, 100); // 尝试分配100KB（超出可用内存）
-    
+
     std::cout << "\n6. 清理所有进程:" << std::endl;
     manager.deallocateMemory(101);
     manager.deallocateMemory(103);
     manager.deallocateMemory(104);
-    
+
     manager.displayMemoryStatus();
+
+    std::cout << "7. 多级页表稀疏地址空间测试:" << std::endl;
+    PagingMemoryManager sparseManager(16, 4, FOUR_LEVEL_PAGE_TABLE);
+    sparseManager.allocateMemory(201, 8);                // 低地址处的代码段（2页）
+    sparseManager.mapRegion(201, 1LL << 40, 8);          // 1TB 处的堆（2页）
+    sparseManager.mapRegion(201, (1LL << 47) - 4096, 4); // 地址空间顶部的栈（1页）
+    sparseManager.translateAddress(201, (1LL << 40) + 5000);
+    sparseManager.translateAddress(201, (1LL << 47) - 100);
+    std::cout << "进程201页表占用: " << sparseManager.getPageTableMemory(201)
+              << " 字节（同样范围的线性页表需要 "
+              << ((1LL << 47) / 4096) * (long long)sizeof(int) << " 字节）" << std::endl;
+    sparseManager.deallocateMemory(201);
+
+    std::cout << "\n8. 哈希倒排页表测试:" << std::endl;
+    PagingMemoryManager invertedManager(16, 4, INVERTED_PAGE_TABLE);
+    invertedManager.allocateMemory(301, 12);
+    invertedManager.allocateMemory(302, 8);
+    invertedManager.mapRegion(302, 1LL << 40, 4);       // 稀疏映射不增加页表开销
+    invertedManager.translateAddress(301, 9000);
+    invertedManager.translateAddress(302, (1LL << 40) + 100);
+    int owner;
+    long long ownerPage;
+    if (invertedManager.getFrameOwner(4, owner, ownerPage)) {
+        std::cout << "页框4属于进程 " << owner << " 的逻辑页 " << ownerPage << std::endl;
+    }
+    invertedManager.deallocateMemory(301);
+    invertedManager.displayMemoryStatus();
+    invertedManager.deallocateMemory(302);
+
+    std::cout << "\n9. 伙伴系统连续分配测试:" << std::endl;
+    PagingMemoryManager buddyManager(16, 4);
+    buddyManager.allocateMemory(401, 4);   // 1页
+    buddyManager.allocateMemory(402, 12);  // 3页
+    buddyManager.allocateMemory(403, 4);   // 1页
+    buddyManager.deallocateMemory(402);    // 留下空洞
+    buddyManager.mapContiguousRegion(401, 1 << 20, 32);  // DMA 缓冲区：8个连续页框
+    buddyManager.mapContiguousRegion(403, 1 << 20, 16);  // 再要4个连续页框
+    buddyManager.displayMemoryStatus();
+    buddyManager.deallocateMemory(401);
+    buddyManager.deallocateMemory(403);
+    std::cout << "全部回收后碎片率: " << buddyManager.getFragmentation() * 100 << "%" << std::endl;
+
+    std::cout << "\n10. 工作集估计测试:" << std::endl;
+    PagingMemoryManager wsManager(16, 4);
+    wsManager.setWorkingSetWindow(8);
+    wsManager.allocateMemory(501, 40);  // 10页，但只在前2页上循环
+    for (int i = 0; i < 20; i++) {
+        wsManager.accessMemory(501, (i % 2) * 4096);
+    }
+    std::cout << "进程501: 驻留 10 页，工作集 " << wsManager.getWorkingSetSize(501) << " 页" << std::endl;
+    std::cout << "能否再接纳 48KB 的进程: " << (wsManager.canAdmit(48) ? "能" : "不能") << std::endl;
+    std::cout << "能否再接纳 60KB 的进程: " << (wsManager.canAdmit(60) ? "能" : "不能") << std::endl;
+    wsManager.deallocateMemory(501);
+
+    std::cout << "\n11. 交换区测试:" << std::endl;
+    PagingMemoryManager swapManager(8, 4);
+    swapManager.enableSwap("", 64, 4, 4);
+    swapManager.allocateMemory(601, 24);  // 三个进程共 18 页，物理内存只有 8 页
+    swapManager.allocateMemory(602, 24);
+    swapManager.allocateMemory(603, 24);
+    for (int round = 0; round < 2; round++) {
+        for (int pid = 601; pid <= 603; pid++) {
+            for (int page = 0; page < 6; page++) {
+                swapManager.accessMemory(pid, page * 4096, page % 2 == 0);
+            }
+        }
+    }
+    swapManager.translateAddress(601, 4096 * 5 + 10);
+    swapManager.swapOutProcess(602);
+    swapManager.showSwapStatus();
+    swapManager.deallocateMemory(601);
+    swapManager.deallocateMemory(602);
+    swapManager.deallocateMemory(603);
+
+    std::cout << "\n12. 轨迹回放与 OPT 对比测试:" << std::endl;
+    std::vector<TraceRecord> trace;
+    for (int round = 0; round < 20; round++) {
+        for (int page = 0; page < 10; page++) {
+            trace.push_back({701, 0, (int64_t)page * 4096});                       // 进程701循环扫描10页
+            trace.push_back({702, 1, (int64_t)(page % 3) * 4096 + (1LL << 40)});  // 进程702反复写3个热点页
+        }
+    }
+    TraceReplay::writeTrace("page_demo.trace", trace);
+    {
+        TraceReplay replay("page_demo.trace");
+        replay.replayAll(8);
+    }
+    std::remove("page_demo.trace");
+
+    std::cout << "\n13. 大页与快表覆盖范围测试:" << std::endl;
+    for (int order = 0; order <= 3; order += 3) {
+        PagingMemoryManager hugeManager(64, 4);
+        hugeManager.setTlbEntries(8);
+        if (order > 0) {
+            hugeManager.enableHugePages(order);  // 32KB 大页
+        }
+        hugeManager.allocateMemory(801, 128);    // 32页的堆，在其上跳跃访问
+        for (int i = 0; i < 2000; i++) {
+            hugeManager.accessMemory(801, (long long)(i * 7 % 32) * 4096 + i % 4096);
+        }
+        std::cout << (order > 0 ? "使用大页:" : "仅基本页:") << std::endl;
+        hugeManager.showTlbStatus();
+        if (order > 0) {
+            hugeManager.unmapRegion(801, 5 * 4096, 4);  // 释放大页中的一页，该大页被拆分
+            hugeManager.translateAddress(801, 4 * 4096);
+            hugeManager.translateAddress(801, 20 * 4096);
+            hugeManager.showTlbStatus();
+        }
+        hugeManager.deallocateMemory(801);
+    }
+
+    std::cout << "\n14. NUMA 拓扑测试:" << std::endl;
+    PagingMemoryManager numaManager(64, 4);
+    numaManager.configureNuma(2, 4);          // 双路：每路 32 个页框、4 个 CPU
+    numaManager.allocateMemory(901, 32, 0);   // CPU 0 上的进程，8 页全在节点 0
+    numaManager.allocateMemory(902, 96, 5);   // CPU 5 上的进程，24 页在节点 1
+    numaManager.allocateMemory(904, 16, 1);
+    numaManager.setNumaPolicy(904, NUMA_INTERLEAVE);
+    numaManager.mapRegion(904, 1 << 20, 32);  // 8 页交错分配到两个节点
+    numaManager.allocateMemory(903, 32, 6);   // 节点 1 只剩 4 页，其余 4 页落到节点 0
+    numaManager.setNumaPolicy(901, NUMA_BIND, 0);
+    numaManager.mapRegion(901, 1 << 20, 64);  // 节点 0 只剩 12 页，绑定策略下 16 页失败
+    for (int i = 0; i < 100; i++) {
+        numaManager.accessMemory(901, (i % 8) * 4096);
+        numaManager.accessMemory(903, (i % 6) * 4096);
+    }
+    numaManager.setProcessCpu(901, 4);        // 进程 901 被迁到节点 1 的 CPU，访问全部变为远端
+    for (int i = 0; i < 100; i++) {
+        numaManager.accessMemory(901, (i % 8) * 4096);
+    }
+    numaManager.showNumaStatus();
+
+    std::cout << "\n15. 共享内存段测试:" << std::endl;
+    PagingMemoryManager shmManager(16, 4, INVERTED_PAGE_TABLE);
+    shmManager.allocateMemory(1001, 8);
+    shmManager.allocateMemory(1002, 8);
+    shmManager.allocateMemory(1003, 8);
+    int segment = shmManager.createSharedSegment(1001, 1 << 20, 16);  // 4 页共享缓冲区
+    shmManager.attachSharedSegment(segment, 1002, 1 << 24);           // 挂接地址可以不同
+    shmManager.attachSharedSegment(segment, 1003, 1 << 20);
+    shmManager.translateAddress(1001, (1 << 20) + 4096 + 8);
+    shmManager.translateAddress(1002, (1 << 24) + 4096 + 8);          // 同一个物理地址
+    shmManager.displayMemoryStatus();
+    shmManager.detachSharedSegment(1001, 1 << 20);
+    shmManager.deallocateMemory(1002);                                // 退出时自动解除挂接
+    std::cout << "空闲页框: " << shmManager.getFreeMemory() / 4 << std::endl;
+    shmManager.detachSharedSegment(1003, 1 << 20);                    // 最后一个挂接者，回收页框
+    std::cout << "空闲页框: " << shmManager.getFreeMemory() / 4 << std::endl;
+    shmManager.deallocateMemory(1001);
+    shmManager.deallocateMemory(1003);
+
+    std::cout << "\n16. 相同页合并测试:" << std::endl;
+    PagingMemoryManager ksmManager(32, 4, FOUR_LEVEL_PAGE_TABLE);
+    const char image[] = "同一个镜像的代码页";
+    for (int pid = 1101; pid <= 1104; pid++) {
+        ksmManager.allocateMemory(pid, 20);                      // 第0、1页内容相同，第2页各不相同，第3页写过后清零，第4页从未写过
+        ksmManager.writeMemory(pid, 0, image, sizeof(image));
+        ksmManager.writeMemory(pid, 4096 + 100, image, sizeof(image));
+        ksmManager.writeMemory(pid, 2 * 4096, &pid, sizeof(pid));
+        long long zero = 0;
+        ksmManager.writeMemory(pid, 3 * 4096, &zero, sizeof(zero));
+    }
+    std::cout << "合并前空闲页框: " << ksmManager.getFreeMemory() / 4 << std::endl;
+    std::cout << "本次合并 " << ksmManager.scanDuplicatePages(32) << " 页" << std::endl;
+    std::cout << "合并后空闲页框: " << ksmManager.getFreeMemory() / 4 << std::endl;
+    const char patch[] = "进程1102修改后的代码页";
+    ksmManager.writeMemory(1102, 0, patch, sizeof(patch));       // 写时复制，其他进程不受影响
+    char text[64];
+    ksmManager.readMemory(1101, 0, text, sizeof(image));
+    std::cout << "进程1101第0页: " << text << std::endl;
+    ksmManager.readMemory(1102, 0, text, sizeof(patch));
+    std::cout << "进程1102第0页: " << text << std::endl;
+    ksmManager.showDedupStatus();
+    for (int pid = 1101; pid <= 1104; pid++) {
+        ksmManager.deallocateMemory(pid);
+    }
+    std::cout << "全部回收后空闲页框: " << ksmManager.getFreeMemory() / 4 << std::endl;
+
+    std::cout << "\n17. 内存规整测试:" << std::endl;
+    PagingMemoryManager compactManager(32, 4);
+    for (int pid = 1201; pid <= 1216; pid++) {
+        compactManager.allocateMemory(pid, 8);           // 16 个进程各占 2 页，占满内存
+    }
+    for (int pid = 1201; pid <= 1216; pid += 2) {
+        compactManager.deallocateMemory(pid);            // 每隔一个进程退出，留下 8 个 2 页的空洞
+    }
+    compactManager.writeMemory(1202, 4096, "迁移前写入的数据", 25);
+    std::cout << "空闲 " << compactManager.getFreeMemory() / 4 << " 页，碎片率 "
+              << compactManager.getFragmentation() * 100 << "%" << std::endl;
+    compactManager.mapContiguousRegion(1202, 1 << 20, 32); // 要 8 个连续页框：触发规整后成功
+    char migrated[32];
+    compactManager.readMemory(1202, 4096, migrated, 25);
+    std::cout << "进程1202迁移后读出: " << migrated << std::endl;
+    compactManager.displayMemoryStatus();
+    for (int pid = 1202; pid <= 1216; pid += 2) {
+        compactManager.deallocateMemory(pid);
+    }
+
+    std::cout << "\n18. 进程频繁创建与销毁测试:" << std::endl;
+    PagingMemoryManager churnManager(256, 4);
+    churnManager.setVerbose(false);
+    for (int pid = 1301; pid <= 1364; pid++) {
+        churnManager.allocateMemory(pid, 16);
+    }
+    const int churnRounds = 100000;
+    auto churnStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < churnRounds; i++) {
+        int pid = 1301 + i % 64;
+        churnManager.deallocateMemory(pid);
+        churnManager.allocateMemory(pid, 4 + i % 4 * 4);  // 1~4 页，进程表项与页表容量被复用
+    }
+    auto churnNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - churnStart).count();
+    std::cout << churnRounds << " 次回收+分配，平均 " << churnNanos / churnRounds << "ns/次，空闲页框 "
+              << churnManager.getFreeMemory() / 4 << std::endl;
+    for (int pid = 1301; pid <= 1364; pid++) {
+        churnManager.deallocateMemory(pid);
+    }
+    std::cout << "全部回收后空闲页框: " << churnManager.getFreeMemory() / 4 << std::endl;
+
+    std::cout << "\n19. 后台回收水位测试:" << std::endl;
+    for (int daemon = 0; daemon <= 1; daemon++) {
+        PagingMemoryManager reclaimManager(32, 4);
+        reclaimManager.setVerbose(false);
+        reclaimManager.enableSwap("", 128, 4, 4);
+        reclaimManager.setWatermarks(2, 4, 8);
+        for (int pid = 1401; pid <= 1404; pid++) {
+            reclaimManager.allocateMemory(pid, 64);  // 4 个进程各 16 页，物理内存只有 32 页
+        }
+        for (int tick = 0; tick < 40; tick++) {
+            // 每个时钟周期：各进程反复访问前 4 页，再顺带访问一个轮换的冷页
+            for (int pid = 1401; pid <= 1404; pid++) {
+                for (int page = 0; page < 4; page++) {
+                    reclaimManager.accessMemory(pid, page * 4096);
+                }
+                reclaimManager.accessMemory(pid, (4 + (tick + pid) % 12) * 4096, true);
+            }
+            if (daemon) {
+                reclaimManager.reclaimPages(8);
+            }
+        }
+        std::cout << (daemon ? "时钟中断中后台回收: " : "只在缺页时同步换出: ");
+        reclaimManager.showSwapStatus();
+        for (int pid = 1401; pid <= 1404; pid++) {
+            reclaimManager.deallocateMemory(pid);
+        }
+    }
+
+    std::cout << "\n20. 顺序缺页预读测试:" << std::endl;
+    for (int limit = 0; limit <= READAHEAD_MAX_PAGES; limit += READAHEAD_MAX_PAGES) {
+        PagingMemoryManager streamManager(32, 4);
+        streamManager.setVerbose(false);
+        streamManager.enableSwap("", 256, 8, 1);  // 簇大小 1：只靠预读批量换入
+        streamManager.setReadaheadLimit(limit);
+        streamManager.allocateMemory(1501, 4 * 96);                   // 96 页，物理内存只有 32 页
+        for (int page = 0; page < 96; page++) {
+            streamManager.writeMemory(1501, page * 4096LL, &page, sizeof(page));
+        }
+        streamManager.swapOutProcess(1501);
+        long long faultsBefore = streamManager.getPageFaults();
+        bool intact = true;
+        for (int page = 0; page < 96; page++) {                       // 顺序扫描
+            int value = -1;
+            streamManager.readMemory(1501, page * 4096LL, &value, sizeof(value));
+            intact = intact && value == page;
+        }
+        for (int page = 1; page < 96; page += 3) {                    // 步长为 3 的扫描
+            int value = -1;
+            streamManager.readMemory(1501, page * 4096LL, &value, sizeof(value));
+            intact = intact && value == page;
+        }
+        std::cout << (limit ? "开启预读: " : "关闭预读: ") << "两次扫描缺页 "
+                  << streamManager.getPageFaults() - faultsBefore << " 次，数据"
+                  << (intact ? "完整" : "损坏") << std::endl;
+        streamManager.showSwapStatus();
+        streamManager.deallocateMemory(1501);
+    }
+
+    std::cout << "\n21. 经地址转换的读写与拷贝测试:" << std::endl;
+    PagingMemoryManager dataManager(1024, 4);                  // 4MB 物理内存
+    dataManager.setVerbose(false);
+    dataManager.allocateMemory(1601, 1024);                    // 1MB，页框连续
+    dataManager.allocateMemory(1602, 1024);
+    std::vector<uint64_t> pattern(1024 * 1024 / sizeof(uint64_t));
+    for (size_t i = 0; i < pattern.size(); i++) {
+        pattern[i] = i * 0x9E3779B97F4A7C15ULL;
+    }
+    dataManager.writeMemory(1601, 0, pattern.data(), 1024 * 1024);
+    for (int round = 0; round < 16; round++) {
+        dataManager.copyMemory(1602, 0, 1601, 0, 1024 * 1024);  // 整段页框连续，每轮一次 memcpy
+    }
+    dataManager.copyMemory(1602, 100, 1601, 4000, 8192);       // 不对齐、跨页
+    uint64_t word = 0;
+    dataManager.storeWord(1601, 4092, 0x1122334455667788ULL);  // 跨页的字
+    dataManager.loadWord(1601, 4092, word);
+    std::vector<uint64_t> check(pattern.size());
+    dataManager.readMemory(1602, 100, check.data(), 8192);
+    std::cout << "跨页字读回 0x" << std::hex << word << std::dec << ", 拷贝结果"
+              << (memcmp(check.data(), (const char*)pattern.data() + 4000, 8192) == 0 ? "正确" : "错误")
+              << std::endl;
+    dataManager.showBandwidthStatus();
+
+    std::cout << "\n22. 压缩交换层测试:" << std::endl;
+    for (int compressed = 0; compressed <= 1; compressed++) {
+        // 同样 128KB 内存：不压缩时全部作为页框；压缩时 96KB 页框 + 32KB 压缩池
+        PagingMemoryManager zManager(compressed ? 24 : 32, 4);
+        zManager.setVerbose(false);
+        zManager.enableSwap("", 256, 4, 1);
+        zManager.setReadaheadLimit(0);
+        if (compressed) {
+            zManager.enableCompressedSwap(32);
+        }
+        char page[4096];
+        unsigned int seed = 12345;
+        for (int pid = 1701; pid <= 1704; pid++) {
+            zManager.allocateMemory(pid, 4 * 24);                     // 4 个进程各 24 页
+            for (int p = 0; p < 24; p++) {
+                if (p % 6 == 5) {
+                    for (char& c : page) c = (char)((seed = seed * 1103515245 + 12345) >> 16);  // 不可压缩
+                } else {
+                    for (int i = 0; i < 4096; i += 64) {
+                        snprintf(page + i, 64, "pid=%d page=%d offset=%-6d payload............", pid, p, i);
+                    }
+                }
+                zManager.writeMemory(pid, p * 4096LL, page, sizeof(page));
+            }
+        }
+        long long faults = zManager.getPageFaults();
+        long long decompressed = zManager.getCompressedFaults();
+        for (int i = 0; i < 2000; i++) {
+            // 随机访问各进程的前 10 页：热点共 40 页，比 32 个页框多，但压缩后放得下
+            seed = seed * 1103515245 + 12345;
+            zManager.readMemory(1701 + (seed >> 16) % 4, (seed >> 20) % 10 * 4096LL + 8, page, 16);
+        }
+        // 压缩池占去 8 个页框，缺页总数反而增加；代价在于其中多数只需解压，读交换区的次数下降
+        faults = zManager.getPageFaults() - faults;
+        decompressed = zManager.getCompressedFaults() - decompressed;
+        std::cout << (compressed ? "24 页框 + 32KB 压缩池: " : "32 页框: ") << "热点访问缺页 " << faults
+                  << " 次 (解压换入 " << decompressed << " 次, 读交换区 " << faults - decompressed << " 次)"
+                  << std::endl;
+        zManager.showSwapStatus();
+        for (int pid = 1701; pid <= 1704; pid++) {
+            zManager.deallocateMemory(pid);
+        }
+    }
+
+    std::cout << "\n23. CPU 缓存与时间片测试:" << std::endl;
+    // 两个进程各 24KB 工作集：单独放得进 32KB 的 L2，两个一起放不下，时间片越短互相挤出越频繁
+    std::vector<CacheLevelConfig> levels = {
+        {"L1", 8, 4, 64, 4, CACHE_LRU},
+        {"L2", 32, 8, 64, 12, CACHE_LRU},
+        {"LLC", 256, 16, 64, 40, CACHE_LRU},
+    };
+    int quanta[] = {16, 256, 4096};
+    for (int quantum : quanta) {
+        PagingMemoryManager cManager(64, 4);
+        cManager.setVerbose(false);
+        cManager.enableCacheModel(levels, 200);
+        cManager.allocateMemory(1801, 24);
+        cManager.allocateMemory(1802, 24);
+        unsigned int seed = 2024;
+        for (int i = 0; i < 65536; i++) {
+            int pid = (i / quantum) % 2 ? 1802 : 1801;
+            seed = seed * 1103515245 + 12345;
+            cManager.accessMemory(pid, (seed >> 12) % (24 * 1024 / 64) * 64);
+        }
+        CacheHierarchy* cache = cManager.getCacheModel();
+        std::cout << "时间片 " << quantum << " 次访问: 平均 " << std::fixed << std::setprecision(1)
+                  << (double)(cache->getCycles(1801) + cache->getCycles(1802)) / 65536 << " 周期, L2 命中率 "
+                  << cache->getHitRate(1) * 100 << "%" << std::endl;
+        if (quantum == quanta[0]) {
+            cManager.showCacheStatus();
+        }
+        cManager.deallocateMemory(1801);
+        cManager.deallocateMemory(1802);
+    }
+
+    std::cout << "\n24. 可增长的地址空间测试:" << std::endl;
+    {
+        PagingMemoryManager sManager(32, 4, TWO_LEVEL_PAGE_TABLE);
+        sManager.createAddressSpace(1901, 8, 0, 8);      // 代码 2 页，空堆，栈 2 页
+        int freeBefore = sManager.getFreeMemory();
+        long long base = sManager.getBreak(1901);
+        for (int step = 1; step <= 4; step++) {
+            // 堆每次扩 16KB，已有的堆页原地不动，新页首次写入时才占用页框
+            sManager.setBreak(1901, base + step * 16 * 1024LL);
+            sManager.storeWord(1901, base + (step - 1) * 16 * 1024LL, 0x1000 + step);
+        }
+        uint64_t first = 0;
+        sManager.loadWord(1901, base, first);
+        std::cout << "堆扩到 64KB 后只占用 " << freeBefore - sManager.getFreeMemory()
+                  << "KB 内存，堆起始处的值 0x" << std::hex << first << std::dec << std::endl;
+
+        long long stackTop = sManager.getStackTop(1901);
+        sManager.growSegment(1901, STACK_SEGMENT, 8);
+        sManager.storeWord(1901, stackTop - 4 * 4096 + 8, 42);
+        sManager.shrinkSegment(1901, HEAP_SEGMENT, 32);
+        std::cout << "收缩后堆顶 0x" << std::hex << sManager.getBreak(1901) << std::dec
+                  << ", 访问已释放的堆页: " << (sManager.accessMemory(1901, base + 40 * 1024) ? "成功" : "失败")
+                  << std::endl;
+        sManager.showSegments(1901);
+        sManager.deallocateMemory(1901);
+    }
 }
 
 int main() {
     runPageManagerDemo();
     return 0;
-}
\ No newline at end of file
+}
@@ -5,46 +5,430 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <functional>
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include "RadixPageTable.h"
+#include "BuddyAllocator.h"
+#include "SwapArea.h"
+#include "CompressedPool.h"
+#include "CacheHierarchy.h"
+#include "Tlb.h"
+
+// 页表组织方式
+enum PageTableType {
+    FLAT_PAGE_TABLE = 0,       // 线性页表：每个逻辑页一个表项
+    TWO_LEVEL_PAGE_TABLE = 1,  // 二级页表：10+10 位，覆盖 32 位虚拟地址空间
+    FOUR_LEVEL_PAGE_TABLE = 2, // 四级页表：4x9 位，覆盖 48 位虚拟地址空间
+    INVERTED_PAGE_TABLE = 3    // 全局哈希倒排页表：按 (进程ID, 虚拟页号) 散列，大小与物理页框数成正比
+};
+
+// 页面置换算法
+enum ReplacementPolicy {
+    FIFO_REPLACEMENT = 0,  // 先进先出
+    LRU_REPLACEMENT = 1,   // 最近最久未使用
+    CLOCK_REPLACEMENT = 2  // 时钟（二次机会）
+};
+
+// NUMA 页框分配策略
+enum NumaPolicy {
+    NUMA_LOCAL_FIRST = 0,  // 优先本地节点，不足时按距离由近及远
+    NUMA_INTERLEAVE = 1,   // 各节点轮流分配
+    NUMA_BIND = 2          // 只在绑定的节点上分配
+};
+
+// 进程地址空间的段
+enum SegmentType {
+    CODE_SEGMENT = 0,   // 代码段：自页 0 起，创建后大小固定
+    HEAP_SEGMENT = 1,   // 堆：紧接代码段向上增长
+    STACK_SEGMENT = 2   // 栈：自栈顶向下增长
+};
 
 class PagingMemoryManager {
 private:
     struct PageFrame {
         bool occupied;      // 页框是否被占用
         int processId;      // 占用该页框的进程ID
-        int pageNumber;     // 逻辑页号
+        long long pageNumber; // 逻辑页号
+        int hashNext;       // 倒排页表中同一散列链的下一个页框，-1 表示链尾
+        bool referenced;    // 访问位，时钟置换算法使用
+        bool dirty;         // 修改位
+        long long loadTime;   // 调入时刻，FIFO 使用
+        long long lastAccess; // 最近访问时刻，LRU 使用
+        bool huge;          // 属于某个大页映射
+        int shareCount;     // 挂接该页框的进程数，0 表示私有页框；共享页框常驻内存，不参与置换
+        bool merged;        // 内容合并后的只读页框，写入时复制
+        bool pinned;        // 物理地址不可改变（连续映射的 DMA 缓冲区），不参与迁移、合并与换出
+        unsigned char age;  // 老化计数：每次回收扫描右移一位，recent 移入最高位，越小越冷
+        bool recent;        // 上次老化扫描后被访问过；老化专用，不动时钟算法的访问位
+        bool prefetched;    // 由预读调入且尚未被访问
+        bool selected;      // 已被本轮选为换出对象，选择结束即清除
+        bool written;       // 调入后被写过或内容来自交换区；从未写过的新页不参与合并
 
         PageFrame();
     };
 
+    // 页框号上的侵入式双向链表：FIFO 按调入顺序、LRU 按访问顺序各维护一条，表头最老
+    // 只链入驻留的私有页框，选择受害页时从表头依次取，不必扫描全部页框
+    struct FrameList {
+        std::vector<int> prev;   // -1 表示表头；不在链表中时为 NOT_LINKED
+        std::vector<int> next;
+        int head;
+        int tail;
+
+        static const int NOT_LINKED = -2;
+
+        void reset(int frames);
+        bool contains(int frameNumber) const;
+        void pushBack(int frameNumber);
+        void remove(int frameNumber);
+        void replace(int from, int to);  // to 接替 from 在链表中的位置
+    };
+
+    // 共享内存段：各挂接进程共用同一组页框，由最后一个解除挂接的进程回收
+    struct SharedSegment {
+        int segmentId;
+        std::vector<int> frames; // 段内第 i 页所在的页框
+        int attachCount;         // 挂接次数
+
+        SharedSegment();
+    };
+
     struct ProcessInfo {
         int processId;
         int pageCount;              // 进程占用的页数
-        std::vector<int> pageTable; // 页表：逻辑页号 -> 物理页框号
+        std::vector<int> pageTable; // 页表：逻辑页号 -> 物理页框号（线性页表）
+        std::shared_ptr<RadixPageTable> radixTable; // 多级页表，内层按需分配
+        std::map<long long, int> hugePages; // 大页：大页号 -> 起始页框，一个表项映射 2^hugePageOrder 个连续页框
+        std::map<long long, int> sharedAttachments; // 挂接的共享段：起始逻辑页号 -> 段号
+        std::unordered_map<long long, int> mergedPages; // 内容合并后的页：逻辑页号 -> 只读共享页框
+
+        // 工作集：最近 workingSetWindow 次访问（进程虚拟时间）的滑动窗口
+        std::deque<long long> referenceWindow;          // 窗口内按时间顺序的页号
+        std::unordered_map<long long, int> windowCounts; // 窗口内各页的访问次数
+        long long referenceCount;                        // 累计访问次数
+
+        // 不驻留内存的页：逻辑页号 -> 交换槽位（-1 表示尚无后备，首次访问时填零；-2 表示在压缩池中）
+        std::unordered_map<long long, int> nonResidentPages;
+        std::unordered_map<long long, int> compressedPages; // 在压缩池中的页：逻辑页号 -> 压缩池句柄
+        long long pageFaults;   // 缺页次数
+        bool swappedOut;        // 整体换出（挂起），不计入工作集总和
+
+        // 预读：由缺页序列识别顺序或固定步长的访问
+        long long lastFaultPage;   // 上次缺页的页号
+        long long faultStride;     // 识别出的步长（页），0 表示尚无
+        long long readaheadNext;   // 预读窗口之后的页，缺页落在这里说明窗口全部用上；-1 表示没有预读
+        int readaheadWindow;       // 当前预读页数
+
+        // 段式布局：代码段 [0, codePages)，堆 [codePages, codePages + heapPages)，
+        // 栈 [stackTopPage - stackPages, stackTopPage)；堆与栈之间至少隔一个保护页
+        long long codePages;
+        long long heapPages;
+        long long heapBreak;       // 堆顶（字节地址），堆页数为其向上取整到页
+        long long stackPages;
+
+        // NUMA
+        int homeNode;           // 所在 CPU 的节点
+        NumaPolicy numaPolicy;
+        int bindNode;           // NUMA_BIND 绑定的节点，-1 表示本地节点
+        int interleaveNext;     // NUMA_INTERLEAVE 下一个分配的节点
+        long long localAccesses;
+        long long remoteAccesses;
 
         ProcessInfo();
-        ProcessInfo(int id, int count);
+
+        // 清空各表但保留容器已分配的容量，进程信息回收后留待下一个进程复用
+        void reset();
     };
 
     int totalFrames;                       // 总页框数
     int frameSize;                         // 页框大小(KB)
+    PageTableType pageTableType;           // 页表组织方式
     std::vector<PageFrame> physicalMemory; // 物理内存页框
-    std::queue<int> freeFrames;            // 空闲页框队列
-    std::map<int, ProcessInfo> processes;  // 进程信息表
+    char* physicalBase;                    // 物理内存：一整块匿名 mmap 区域，页框 i 位于 i * 页大小 处，空闲页框保持全零
+    size_t physicalBytes;
+    std::vector<BuddyAllocator> nodeAllocators; // 各 NUMA 节点的空闲页框：位图 + 伙伴系统
+    // 进程表：以进程ID为下标；进程回收后表项保留，processId 为 -1，下次分配时复用
+    std::vector<std::unique_ptr<ProcessInfo>> processTable;
+    int processCount;                      // 存活的进程数
+    std::vector<int> frameBatch;           // 分配与回收时暂存页框号，容量跨调用复用
+    std::vector<long long> hugeRegions;    // 大页提升时暂存各基本页所属的对齐区域，容量跨调用复用
+    bool verbose;                          // 分配与回收时是否输出详细信息
+    std::vector<int> hashAnchor;           // 倒排页表散列锚点：散列值 -> 链首页框
+    std::map<int, SharedSegment> sharedSegments; // 共享内存段
+    int nextSegmentId;
+    int workingSetWindow;                  // 工作集窗口大小 τ（访问次数）
+
+    // 交换
+    std::unique_ptr<SwapArea> swapArea;    // 交换区，未启用时为空
+    int swapBatchSize;                     // 每次换出的页数
+    int swapClusterSize;                   // 换入时一次读取的相邻槽位数
+    std::unique_ptr<CompressedPool> compressedPool; // 交换区之前的压缩内存层，未启用时为空
+    long long compressedOut;               // 压缩进池的页数
+    long long compressedFaults;            // 从池中解压换入的次数
+    long long compressedWriteback;         // 池满时写回交换区的冷页数
+    ReplacementPolicy replacementPolicy;   // 页面置换算法
+    int clockHand;                         // 时钟置换指针
+    int coldHand;                          // 后台回收选冷页的扫描指针
+    std::vector<int> coldCandidates;       // 后台回收每批的候选页框，容量跨调用复用
+    FrameList loadOrder;                   // FIFO 链表：按调入顺序
+    FrameList accessOrder;                 // LRU 链表：按最近访问顺序
+    long long accessClock;                 // 逻辑时钟：每次调入或访问加一
+    long long committedPages;              // 所有进程的虚拟页总数（含不驻留的页）
+    std::unordered_map<int, int> reservations; // 已接纳、尚未提交的进程：进程ID -> 预留页数
+    long long reservedPages;               // 预留页数之和，计入工作集总和与可提交总量
+    long long pageFaultCount;              // 缺页总数
+    long long demandZeroFaults;            // 其中首次访问填零的次数
+    long long clusterReadPages;            // 随簇读入的相邻页数
+    std::vector<char> ioBuffer;            // 批量换入换出的缓冲区
+
+    // 后台回收：空闲页框低于 low 水位时唤醒，成批换出最冷的页直到回到 high 水位；
+    // 新进程的驻留页不占用 min 水位以下的页框，留给缺页处理，避免其同步换出
+    int minWatermark;
+    int lowWatermark;
+    int highWatermark;
+    bool reclaimActive;                    // 已低于 low 水位、尚未回到 high 水位
+    long long reclaimWakeups;              // 后台回收被唤醒的次数
+    long long reclaimedPages;              // 后台回收换出的页数
+    long long directReclaims;              // 没有空闲页框、缺页处理同步换出的次数
+
+    // 预读
+    int readaheadLimit;                    // 预读窗口上限（页），0 表示关闭预读
+    long long readaheadBatches;            // 预读次数
+    long long prefetchedPages;             // 预读调入的页数
+    long long prefetchHits;                // 其中之后被访问的
+    long long prefetchWasted;              // 其中未被访问就换出或回收的
+
+    // 经地址转换的读写与拷贝
+    long long transferCalls;
+    long long transferRuns;                // memcpy 次数：物理连续的页合成一段，一次拷贝
+    long long transferBytes;
+    long long transferNanos;
+
+    // CPU 缓存模型：访存与读写拷贝经地址转换得到的物理地址送入缓存层次，未启用时为空
+    std::unique_ptr<CacheHierarchy> cacheModel;
+    struct CacheRange {
+        int processId;
+        long long address;
+        long long length;
+    };
+    std::vector<CacheRange> pendingRanges; // 读写拷贝时暂存的物理地址段，计时结束后才送入缓存模型
+
+    // 相同页合并
+    int zeroFrame;                                  // 所有全零页合并到的页框，-1 表示尚无
+    std::unordered_multimap<uint64_t, int> stableFrames;   // 已合并页框：内容散列 -> 页框
+    std::unordered_map<uint64_t, int> unstableFrames;      // 本轮扫描见过的私有页：内容散列 -> 页框
+    int scanCursor;                                 // 扫描到的页框
+    long long mergedMappings;                       // 映射到合并页框的逻辑页数
+    long long pagesScanned;
+    long long zeroPagesMerged;
+    long long cowBreaks;                            // 写时复制次数
+
+    // 内存规整：迁移扫描自节点低端向上找可迁移的页，空闲扫描自高端向下找空闲页框，
+    // 把低端的页搬到高端，在低端拼出大的连续空闲块
+    int compactionOrder;                   // 待满足的连续块阶数，-1 表示没有规整请求
+    int compactionNode;                    // 需要规整的节点
+    std::vector<int> migrateCursor;        // 各节点迁移扫描位置
+    std::vector<int> freeCursor;           // 各节点空闲扫描位置
+    long long compactionRequests;
+    long long pagesMigrated;
+
+    // 大页与快表
+    int hugePageOrder;                     // 大页阶数（一个大页 2^hugePageOrder 个页框），0 表示未启用
+    Tlb tlb;                               // 快表
+    long long hugePromotions;              // 大页提升次数
+    long long hugeDemotions;               // 大页拆分次数
+
+    // NUMA 拓扑
+    int framesPerNode;                     // 每个节点的页框数（最后一个节点含余数）
+    int cpusPerNode;                       // 每个节点的 CPU 数
+    std::vector<std::vector<int>> nodeDistance; // 节点距离矩阵，本地为 10
+    std::vector<std::vector<int>> nodeFallback; // 各节点按距离由近及远的节点顺序
+    NumaPolicy defaultNumaPolicy;          // 新进程的分配策略
+    long long localAccessCount;            // 访问本地节点的次数
+    long long remoteAccessCount;           // 访问远端节点的次数
+    long long accessLatencyNanos;          // 按距离折算的访存延迟总和
+
+    // 页表操作，屏蔽线性页表与多级页表的差异
+    ProcessInfo* findProcess(int processId);
+    ProcessInfo* acquireProcess(int processId);
+    int lookupPage(const ProcessInfo& process, long long pageNumber) const;
+    bool mapPage(ProcessInfo& process, long long pageNumber, int frameNumber);
+    void forEachMapping(const ProcessInfo& process,
+                        const std::function<void(long long, int)>& visit) const;
+    size_t pageTableMemory(const ProcessInfo& process) const;
+    long long virtualPageLimit(const ProcessInfo& process) const;
+    long long stackTopPage(const ProcessInfo& process) const;
+    bool checkRegion(ProcessInfo& process, long long firstPage, long long lastPage);
+    long long commitLimit() const;
+    bool reserveRange(ProcessInfo& process, long long firstPage, long long lastPage);
+    int releaseRange(ProcessInfo& process, long long firstPage, long long lastPage);
+    bool resizeSegment(ProcessInfo& process, SegmentType segment, long long pages);
+    void installFrames(ProcessInfo& process, long long firstPage, const std::vector<int>& frames);
+    void recordReference(ProcessInfo& process, long long pageNumber);
+    int workingSetOf(const ProcessInfo& process) const;
+
+    // 请求调页与交换
+    void unmapPage(ProcessInfo& process, long long pageNumber, int frameNumber);
+    int swapOutFrames(const std::vector<int>& victims);
+    int writeSwapSlots(const std::vector<int>& victims);
+    bool compressFrame(int frameNumber);
+    int writebackCompressed(int count);
+    int selectVictims(int count, std::vector<int>& victims, int node = -1);
+    int evictPages(int count, int node = -1);
+    int discardZeroFrames(const std::vector<int>& victims);
+    void agePages();
+    int selectColdVictims(int count, std::vector<int>& victims);
+    bool handlePageFault(ProcessInfo& process, long long pageNumber);
+    bool installFromSlot(ProcessInfo& process, long long pageNumber, int slot, const char* data);
+    void readahead(ProcessInfo& process, long long pageNumber);
+
+    // 页内容与地址转换
+    char* frameBytes(int frameNumber);
+    int touchPage(ProcessInfo& process, long long pageNumber, bool write);
+    int translateRun(ProcessInfo& process, long long logicalAddress, int length, bool write, char*& bytes);
+    void recordTransfer(long long bytes, std::chrono::steady_clock::time_point start);
+    void feedCacheModel();
+
+    // 相同页合并
+    uint64_t hashFrame(int frameNumber);
+    bool isZeroFrame(int frameNumber);
+    bool isMovable(int frameNumber);
+    void makeMerged(int frameNumber);
+    void mergeInto(int frameNumber, int target);
+    void dropMergedPage(ProcessInfo& process, std::unordered_map<long long, int>::iterator merged);
+    int breakCow(ProcessInfo& process, long long pageNumber);
+
+    // 内存规整
+    void resetCompactionCursors();
+    void migrateFrame(int from, int to);
+
+    // 大页
+    void releaseFrame(int frameNumber);
+    void moveFrame(int from, int to);
+    bool promoteRegion(ProcessInfo& process, long long hugeNumber);
+    void demoteHugePage(ProcessInfo& process, long long hugeNumber);
+
+    // 共享内存段
+    void detachAttachment(ProcessInfo& process, std::map<long long, int>::iterator attachment);
+
+    // NUMA 页框池
+    int nodeOf(int frameNumber) const;
+    int boundNode(const ProcessInfo& process) const;
+    int freeFrameCount() const;
+    int availableFrames(const ProcessInfo& process) const;
+    int allocateFrames(ProcessInfo& process, int order);
+    void allocateFrameBatch(ProcessInfo& process, int count, std::vector<int>& frames);
+    void freeFrames(int frameNumber, int order);
+
+    // 倒排页表操作
+    int hashSlot(int processId, long long pageNumber) const;
+    void unlinkFrame(int frameNumber);
 
 public:
-    PagingMemoryManager(int frames, int size);
+    PagingMemoryManager(int frames, int size, PageTableType type = FLAT_PAGE_TABLE);
+    ~PagingMemoryManager();
+
+    PagingMemoryManager(const PagingMemoryManager&) = delete;
+    PagingMemoryManager& operator=(const PagingMemoryManager&) = delete;
+
+    // 为进程分配内存；cpu 为进程运行的 CPU，决定其本地节点，-1 表示取空闲页框最多的节点
+    bool allocateMemory(int processId, int memorySize, int cpu = -1);
+
+    // 在进程虚拟地址空间的任意位置映射一段内存（稀疏地址空间）
+    bool mapRegion(int processId, long long virtualAddress, int memorySize);
 
-    // 为进程分配内存
-    bool allocateMemory(int processId, int memorySize);
+    // 只保留一段虚拟地址而不分配页框（类似不预先填充的 mmap），首次访问时调入
+    bool reservePages(int processId, long long virtualAddress, int memorySize);
+
+    // 映射一段物理连续的内存（DMA 缓冲区等），返回起始页框号，失败返回 -1
+    int mapContiguousRegion(int processId, long long virtualAddress, int memorySize);
+
+    // 创建分段的地址空间：代码段立即分配页框，堆与栈只在页表中保留按需调入的页，首次访问时才占用页框
+    // allocateMemory 创建的进程相当于只有代码段，同样可以增长堆与栈
+    bool createAddressSpace(int processId, int codeSize, int heapSize, int stackSize, int cpu = -1);
+
+    // 堆向上、栈向下增长或收缩 memorySize KB：就地增删页表中的页，已有的页不移动也不复制；
+    // 增长时碰到其他映射、越过堆栈之间的保护页或超出可提交的总量则失败；代码段不能改变大小
+    bool growSegment(int processId, SegmentType segment, int memorySize);
+    bool shrinkSegment(int processId, SegmentType segment, int memorySize);
+
+    // 将堆顶设为 address（字节），按页增减堆，返回新的堆顶，失败返回 -1；类似 brk
+    long long setBreak(int processId, long long address);
+    long long getBreak(int processId);
+    // 栈顶（字节地址，不含）：由页表能表示的虚拟页数决定，进程不存在返回 -1
+    long long getStackTop(int processId);
+
+    // 显示进程各段的地址范围与驻留页数
+    void showSegments(int processId);
+
+    // 预留与提交：接纳进程时先按大小预留容量（计入工作集总和与 页框 + 交换槽位 的可提交总量），
+    // 进程首次运行时再提交为实际分配，同一进程只分配一次；容量不足时预留失败，由调用者排队等待
+    bool reserveMemory(int processId, int memorySize);
+    bool commitMemory(int processId, int cpu = -1);
+    bool cancelReservation(int processId);
+    bool hasReservation(int processId);
+    bool isAllocated(int processId);
+    long long getReservedPages();
 
     // 回收进程内存
     bool deallocateMemory(int processId);
 
+    // 回收进程的一段虚拟地址（部分释放），覆盖到的大页先拆分为基本页
+    bool unmapRegion(int processId, long long virtualAddress, int memorySize);
+
+    // 创建共享内存段并挂接到创建者的 virtualAddress 处，返回段号，失败返回 -1
+    int createSharedSegment(int processId, long long virtualAddress, int memorySize);
+
+    // 将共享段挂接到进程的 virtualAddress 处，与其他挂接者共用同一组页框
+    bool attachSharedSegment(int segmentId, int processId, long long virtualAddress);
+
+    // 解除进程在 virtualAddress 处的挂接；最后一个挂接者解除时回收页框
+    bool detachSharedSegment(int processId, long long virtualAddress);
+
     // 逻辑地址转换为物理地址
-    int translateAddress(int processId, int logicalAddress);
+    long long translateAddress(int processId, long long logicalAddress);
+
+    // 进程访问一个逻辑地址（不输出），记录引用供工作集估计，地址无效返回 false
+    bool accessMemory(int processId, long long logicalAddress, bool write = false);
+
+    // 经地址转换读写进程内存，可跨页；物理上连续的页一次拷贝；写入已合并的页时写时复制
+    bool writeMemory(int processId, long long logicalAddress, const void* data, int length);
+    bool readMemory(int processId, long long logicalAddress, void* data, int length);
+
+    // 读写一个 8 字节的字
+    bool loadWord(int processId, long long logicalAddress, uint64_t& value);
+    bool storeWord(int processId, long long logicalAddress, uint64_t value);
+
+    // 在两段虚拟地址之间拷贝（可跨进程），页框之间直接拷贝，不经中间缓冲区；同一进程内两段重叠时失败
+    bool copyMemory(int destinationProcessId, long long destination,
+                    int sourceProcessId, long long source, int length);
+
+    // 读写与拷贝的累计字节数、耗时与带宽
+    void showBandwidthStatus();
+
+    // 启用 CPU 缓存模型，之后 accessMemory、translateAddress 与读写拷贝的物理地址都送入缓存层次；
+    // 配置无效时返回 false。重新启用会清空缓存与统计
+    bool enableCacheModel(const std::vector<CacheLevelConfig>& levels = CacheHierarchy::defaultConfig(),
+                          int memoryCycles = 200);
+    CacheHierarchy* getCacheModel();
+    void showCacheStatus();
+
+    // 后台扫描 pageCount 个页框，将内容相同的私有页合并为一个只读页框，全零页合并到同一个零页框
+    // 返回本次合并的页数
+    int scanDuplicatePages(int pageCount);
+    long long getFramesSaved();
+    void showDedupStatus();
+
+    // 关闭后分配与回收成功时不再输出，适合进程频繁创建销毁的场景
+    void setVerbose(bool enabled);
 
     // 显示内存状态
     void displayMemoryStatus();
@@ -54,9 +438,101 @@ public:
 
     // 获取空闲内存大小
     int getFreeMemory();
+
+    // 获取外部碎片率（0~1）
+    double getFragmentation();
+
+    // 工作集估计：窗口内访问过的不同页数；尚无访问记录时取驻留页数
+    void setWorkingSetWindow(int window);
+    int getWorkingSetSize(int processId);
+    int getTotalWorkingSet();
+
+    // 所有进程的工作集之和超过物理页框数即视为抖动
+    bool isThrashing();
+
+    // 再接纳一个需要 memorySize KB 的进程后工作集之和（含已预留的页）是否仍不超过物理页框数
+    bool canAdmit(int memorySize);
+
+    // 进程号有效且未被占用、大小不超过物理页框数与可提交总量时返回 true；
+    // 返回 false 的请求等到其他进程全部退出也无法接纳，不应排队
+    bool isAdmissible(int processId, int memorySize);
+
+    int getTotalFrames();
+
+    // 启用交换区：slotCount 个槽位的宿主机文件，之后分配可超过物理页框数
+    // path 为空时在临时目录建匿名文件，同时运行的多个实例不会互相覆盖
+    bool enableSwap(const std::string& path, int slotCount, int batchSize = 8, int clusterSize = 8);
+    bool isSwapEnabled();
+
+    // 在交换区之前启用 poolKB 大小的压缩内存层：换出的页先压缩进池，不可压缩的页直接写入交换区，
+    // 池满时最早进池的冷页写回交换区；需先启用交换区
+    bool enableCompressedSwap(int poolKB);
+
+    // 将进程全部驻留页换出（挂起），之后访问时按需换入
+    int swapOutProcess(int processId);
+
+    // 恢复被换出的进程：重新计入工作集，页面仍在访问时按需换入
+    void resumeProcess(int processId);
+
+    // 连续分配失败时请求规整：之后每次 compactMemory 迁移一批页，直到节点上出现 2^order 的空闲块
+    void requestCompaction(int order, int node = 0);
+
+    // 执行一步规整，最多迁移 maxPages 页，返回迁移的页数；没有规整请求时不做任何事
+    int compactMemory(int maxPages);
+
+    // 启用大页：一个大页 2^order 个页框，由一个页表项映射
+    bool enableHugePages(int order);
+
+    // 将进程中全部驻留的、对齐的 2^order 页区域提升为大页（页框不连续时先迁移），返回提升个数
+    int promoteHugePages(int processId);
+
+    // 对所有未挂起的进程执行一次大页提升扫描
+    int scanHugePages();
+
+    // 配置 NUMA 拓扑：页框平均分到 nodeCount 个节点，距离矩阵为空时本地 10、远端 21
+    // 只能在尚无进程时调用
+    bool configureNuma(int nodeCount, int cpusPerNode,
+                       const std::vector<std::vector<int>>& distances = std::vector<std::vector<int>>());
+    void setDefaultNumaPolicy(NumaPolicy policy);
+    // NUMA_BIND 必须指定有效的节点；其他策略不用 node，只能是 -1 或有效节点
+    bool setNumaPolicy(int processId, NumaPolicy policy, int node = -1);
+
+    // 进程被调度到另一个 CPU：本地节点随之改变，已分配的页框不迁移
+    bool setProcessCpu(int processId, int cpu);
+
+    int getNodeCount();
+    long long getRemoteAccesses();
+    void showNumaStatus();
+
+    void setTlbEntries(int entries);
+    void showTlbStatus();
+
+    // 设置空闲页框水位（页框数），要求 0 < min <= low <= high < 总页框数
+    bool setWatermarks(int minFrames, int lowFrames, int highFrames);
+
+    // 后台回收一步（由时钟中断调用）：老化所有页框的访问位；空闲页框低于 low 水位时成批换出最冷的页，
+    // 直到回到 high 水位或本次已换出 maxPages 页，返回换出的页数。未启用交换区时不做任何事
+    int reclaimPages(int maxPages);
+
+    // 预读窗口上限（页）：缺页呈顺序或固定步长时从交换区成批预读后续页，窗口按命中情况伸缩；0 关闭预读
+    void setReadaheadLimit(int pages);
+
+    void setReplacementPolicy(ReplacementPolicy policy);
+    long long getPageFaults();
+    long long getCompressedFaults();  // 从压缩池解压换入、不读交换区的缺页次数
+    void showSwapStatus();
+
+    // 获取进程页表占用的内存（字节），进程不存在返回 0
+    size_t getPageTableMemory(int processId);
+
+    // 获取所有页表占用的内存（字节），倒排页表模式下为全局表的大小
+    size_t getTotalPageTableMemory();
+
+    // 反向查找：页框 -> (进程ID, 逻辑页号)，页框空闲返回 false；共享页框返回进程ID -1 和段内页号
+    bool getFrameOwner(int frameNumber, int& processId, long long& pageNumber);
 };
 
 // 测试函数声明
 void runPageManagerDemo();
 
-#endif // PAGEMNG_H
\ No newline at end of file
+#endif // PAGEMNG_H
@@ -0,0 +1,172 @@
+#include "RadixPageTable.h"
+#include <algorithm>
+
+RadixPageTable::Node::Node(bool leaf, int fanout) : used(0) {
+    if (leaf) {
+        entries.resize(fanout, -1);
+    } else {
+        children.resize(fanout, nullptr);
+    }
+}
+
+RadixPageTable::RadixPageTable(int levels, int bitsPerLevel)
+    : levels(levels), bitsPerLevel(bitsPerLevel), fanout(1 << bitsPerLevel),
+      root(nullptr), nodeCount(0), leafNodeCount(0), mappedCount(0), unmapPath(levels, nullptr) {
+    // 根节点常驻，其余各级按需分配
+    root = new Node(levels == 1, fanout);
+    nodeCount = 1;
+    if (levels == 1) leafNodeCount = 1;
+}
+
+RadixPageTable::~RadixPageTable() {
+    freeNode(root, 0);
+}
+
+int RadixPageTable::indexAt(long long virtualPage, int level) const {
+    int shift = (levels - 1 - level) * bitsPerLevel;
+    return (int)((virtualPage >> shift) & (fanout - 1));
+}
+
+void RadixPageTable::freeNode(Node* node, int level) {
+    if (!node) return;
+    if (level < levels - 1) {
+        for (Node* child : node->children) {
+            freeNode(child, level + 1);
+        }
+    }
+    delete node;
+}
+
+void RadixPageTable::clearNode(Node* node, int level) {
+    if (level == levels - 1) {
+        if (node->used > 0) {
+            std::fill(node->entries.begin(), node->entries.end(), -1);
+            node->used = 0;
+        }
+        return;
+    }
+    for (Node* child : node->children) {
+        if (child) clearNode(child, level + 1);
+    }
+}
+
+int RadixPageTable::lookup(long long virtualPage) const {
+    if (virtualPage < 0 || virtualPage >= getMaxVirtualPages()) {
+        return -1;
+    }
+
+    const Node* node = root;
+    for (int level = 0; level < levels - 1; level++) {
+        node = node->children[indexAt(virtualPage, level)];
+        if (!node) return -1;
+    }
+    return node->entries[indexAt(virtualPage, levels - 1)];
+}
+
+bool RadixPageTable::map(long long virtualPage, int frameNumber) {
+    if (virtualPage < 0 || virtualPage >= getMaxVirtualPages()) {
+        return false;
+    }
+
+    Node* node = root;
+    for (int level = 0; level < levels - 1; level++) {
+        Node*& child = node->children[indexAt(virtualPage, level)];
+        if (!child) {
+            // 缺页表：分配下一级页表
+            bool leaf = (level + 1 == levels - 1);
+            child = new Node(leaf, fanout);
+            node->used++;
+            nodeCount++;
+            if (leaf) leafNodeCount++;
+        }
+        node = child;
+    }
+
+    int& entry = node->entries[indexAt(virtualPage, levels - 1)];
+    if (entry == -1) {
+        node->used++;
+        mappedCount++;
+    }
+    entry = frameNumber;
+    return true;
+}
+
+int RadixPageTable::unmap(long long virtualPage) {
+    if (virtualPage < 0 || virtualPage >= getMaxVirtualPages()) {
+        return -1;
+    }
+
+    // 记录查找路径，以便自底向上回收空节点
+    std::vector<Node*>& path = unmapPath;
+    Node* node = root;
+    for (int level = 0; level < levels - 1; level++) {
+        path[level] = node;
+        node = node->children[indexAt(virtualPage, level)];
+        if (!node) return -1;
+    }
+    path[levels - 1] = node;
+
+    int& entry = node->entries[indexAt(virtualPage, levels - 1)];
+    int frameNumber = entry;
+    if (frameNumber == -1) return -1;
+
+    entry = -1;
+    node->used--;
+    mappedCount--;
+
+    for (int level = levels - 1; level > 0 && path[level]->used == 0; level--) {
+        delete path[level];
+        nodeCount--;
+        if (level == levels - 1) leafNodeCount--;
+        path[level - 1]->children[indexAt(virtualPage, level - 1)] = nullptr;
+        path[level - 1]->used--;
+    }
+    return frameNumber;
+}
+
+void RadixPageTable::clear() {
+    // 只清空叶子表项，内层节点与叶子节点都保留，下一个进程映射相近的地址时不再分配
+    clearNode(root, 0);
+    mappedCount = 0;
+}
+
+void RadixPageTable::walk(const Node* node, int level, long long prefix,
+                          const std::function<void(long long, int)>& visit) const {
+    if (level == levels - 1) {
+        for (int i = 0; i < fanout; i++) {
+            if (node->entries[i] != -1) {
+                visit((prefix << bitsPerLevel) | i, node->entries[i]);
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < fanout; i++) {
+        if (node->children[i]) {
+            walk(node->children[i], level + 1, (prefix << bitsPerLevel) | i, visit);
+        }
+    }
+}
+
+void RadixPageTable::forEach(const std::function<void(long long, int)>& visit) const {
+    walk(root, 0, 0, visit);
+}
+
+size_t RadixPageTable::getMemoryUsage() const {
+    // 每个节点一张表项数组：内层存指针，叶子存页框号
+    size_t innerNodeSize = sizeof(Node) + fanout * sizeof(Node*);
+    size_t leafNodeSize = sizeof(Node) + fanout * sizeof(int);
+    return (size_t)(nodeCount - leafNodeCount) * innerNodeSize
+         + (size_t)leafNodeCount * leafNodeSize;
+}
+
+int RadixPageTable::getNodeCount() const {
+    return nodeCount;
+}
+
+int RadixPageTable::getMappedCount() const {
+    return mappedCount;
+}
+
+long long RadixPageTable::getMaxVirtualPages() const {
+    return 1LL << (levels * bitsPerLevel);
+}
@@ -0,0 +1,65 @@
+#ifndef RADIXPAGETABLE_H
+#define RADIXPAGETABLE_H
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+// 多级（基数树）页表：内层页表按需分配，适合稀疏的大虚拟地址空间
+// 例如 2 级 x 10 位对应 32 位地址空间，4 级 x 9 位对应 x86-64 的 48 位地址空间
+class RadixPageTable {
+private:
+    struct Node {
+        std::vector<Node*> children; // 内层节点：下一级页表
+        std::vector<int> entries;    // 叶子节点：页表项（物理页框号，-1 表示未映射）
+        int used;                    // 已使用的表项数，为 0 时回收该节点
+
+        Node(bool leaf, int fanout);
+    };
+
+    int levels;        // 页表级数
+    int bitsPerLevel;  // 每级索引位数
+    int fanout;        // 每个节点的表项数
+    Node* root;
+    int nodeCount;     // 已分配的节点数
+    int leafNodeCount; // 其中叶子节点数
+    int mappedCount;   // 已映射的页数
+    std::vector<Node*> unmapPath; // unmap 记录查找路径用，避免每次分配
+
+    int indexAt(long long virtualPage, int level) const;
+    void freeNode(Node* node, int level);
+    void clearNode(Node* node, int level);
+    void walk(const Node* node, int level, long long prefix,
+              const std::function<void(long long, int)>& visit) const;
+
+public:
+    RadixPageTable(int levels, int bitsPerLevel);
+    ~RadixPageTable();
+
+    RadixPageTable(const RadixPageTable&) = delete;
+    RadixPageTable& operator=(const RadixPageTable&) = delete;
+
+    // 查找虚拟页对应的页框号，未映射返回 -1
+    int lookup(long long virtualPage) const;
+
+    // 建立映射，沿途缺失的内层页表按需分配
+    bool map(long long virtualPage, int frameNumber);
+
+    // 解除映射并返回原页框号，空节点随之回收
+    int unmap(long long virtualPage);
+
+    // 解除全部映射但保留已分配的各级节点，页表对象可被下一个进程复用
+    void clear();
+
+    // 按虚拟页号升序遍历所有有效映射
+    void forEach(const std::function<void(long long, int)>& visit) const;
+
+    // 页表本身占用的内存（字节）
+    size_t getMemoryUsage() const;
+
+    int getNodeCount() const;
+    int getMappedCount() const;
+    long long getMaxVirtualPages() const;
+};
+
+#endif // RADIXPAGETABLE_H
@@ -0,0 +1,183 @@
+#include "SwapArea.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+SwapArea::SwapArea(const std::string& path, int slotCount, int pageBytes)
+    : path(path), fd(-1), anonymous(path.empty()), slotCount(slotCount), pageBytes(pageBytes), freeSlots(slotCount),
+      cursor(0), pagesOut(0), pagesIn(0), writeOps(0), readOps(0), writeNanos(0), readNanos(0) {
+    usedBitmap.assign((slotCount + 63) / 64, 0);
+    owners.assign(slotCount, SlotOwner{-1, -1});
+
+    if (anonymous) {
+        const char* dir = getenv("TMPDIR");
+        std::string name = std::string(dir && *dir ? dir : "/tmp") + "/os_sim_swap.XXXXXX";
+        std::vector<char> buffer(name.begin(), name.end());
+        buffer.push_back('\0');
+        fd = mkstemp(buffer.data());
+        if (fd >= 0) {
+            this->path = buffer.data();
+            unlink(buffer.data());  // 文件随描述符关闭而消失，进程异常退出也不留下残余
+        }
+    } else {
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    }
+    if (fd < 0) {
+        std::cout << "交换区创建失败: 无法打开 " << (anonymous ? "临时文件" : path) << std::endl;
+        freeSlots = 0;
+        return;
+    }
+    // 预先设定文件长度（稀疏文件，不实际占用磁盘）
+    if (ftruncate(fd, (off_t)slotCount * pageBytes) != 0) {
+        std::cout << "交换区创建失败: 无法设置文件大小" << std::endl;
+        close(fd);
+        fd = -1;
+        freeSlots = 0;
+        return;
+    }
+
+    std::cout << "交换区已创建: " << this->path << (anonymous ? " (已删除)" : "") << " (" << slotCount << " 个槽位, "
+              << (long long)slotCount * pageBytes / 1024 << "KB)" << std::endl;
+}
+
+SwapArea::~SwapArea() {
+    if (fd >= 0) {
+        close(fd);
+        if (!anonymous) {
+            unlink(path.c_str());  // 交换区只在本次运行中有效
+        }
+    }
+}
+
+bool SwapArea::isOpen() const {
+    return fd >= 0;
+}
+
+bool SwapArea::slotUsed(int slot) const {
+    return (usedBitmap[slot >> 6] >> (slot & 63)) & 1ULL;
+}
+
+void SwapArea::markSlot(int slot, bool used) {
+    if (used) {
+        usedBitmap[slot >> 6] |= 1ULL << (slot & 63);
+    } else {
+        usedBitmap[slot >> 6] &= ~(1ULL << (slot & 63));
+    }
+}
+
+int SwapArea::allocateSlots(int count) {
+    if (fd < 0 || count <= 0 || count > freeSlots) return -1;
+
+    // 从游标开始循环查找长度为 count 的连续空闲段
+    int run = 0;
+    for (int scanned = 0; scanned < slotCount + count; scanned++) {
+        int slot = (cursor + scanned) % slotCount;
+        if (slot == 0) run = 0;  // 槽位段不跨越文件末尾
+        if (slotUsed(slot)) {
+            run = 0;
+            continue;
+        }
+        if (++run == count) {
+            int first = slot - count + 1;
+            for (int i = first; i <= slot; i++) {
+                markSlot(i, true);
+            }
+            freeSlots -= count;
+            cursor = (slot + 1) % slotCount;
+            return first;
+        }
+    }
+    return -1;
+}
+
+void SwapArea::freeSlot(int slot) {
+    if (slot < 0 || slot >= slotCount || !slotUsed(slot)) return;
+    markSlot(slot, false);
+    owners[slot] = SlotOwner{-1, -1};
+    freeSlots++;
+}
+
+void SwapArea::setSlotOwner(int slot, int processId, long long pageNumber) {
+    if (slot < 0 || slot >= slotCount) return;
+    owners[slot] = SlotOwner{processId, pageNumber};
+}
+
+bool SwapArea::getSlotOwner(int slot, int& processId, long long& pageNumber) const {
+    if (slot < 0 || slot >= slotCount || !slotUsed(slot) || owners[slot].processId == -1) {
+        return false;
+    }
+    processId = owners[slot].processId;
+    pageNumber = owners[slot].pageNumber;
+    return true;
+}
+
+bool SwapArea::writeSlots(int firstSlot, int count, const char* data) {
+    if (fd < 0) return false;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = (size_t)count * pageBytes;
+    ssize_t written = pwrite(fd, data, bytes, (off_t)firstSlot * pageBytes);
+    auto end = std::chrono::steady_clock::now();
+
+    writeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    writeOps++;
+    if (written != (ssize_t)bytes) {
+        std::cout << "交换区写入失败: 槽位 " << firstSlot << std::endl;
+        return false;
+    }
+    pagesOut += count;
+    return true;
+}
+
+bool SwapArea::readSlots(int firstSlot, int count, char* data) {
+    if (fd < 0) return false;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = (size_t)count * pageBytes;
+    ssize_t got = pread(fd, data, bytes, (off_t)firstSlot * pageBytes);
+    auto end = std::chrono::steady_clock::now();
+
+    readNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    readOps++;
+    if (got != (ssize_t)bytes) {
+        std::cout << "交换区读取失败: 槽位 " << firstSlot << std::endl;
+        return false;
+    }
+    pagesIn += count;
+    return true;
+}
+
+int SwapArea::getSlotCount() const {
+    return slotCount;
+}
+
+int SwapArea::getFreeSlots() const {
+    return freeSlots;
+}
+
+long long SwapArea::getPagesOut() const {
+    return pagesOut;
+}
+
+long long SwapArea::getPagesIn() const {
+    return pagesIn;
+}
+
+double SwapArea::getAverageWriteLatency() const {
+    return pagesOut ? writeNanos / 1000.0 / pagesOut : 0.0;
+}
+
+double SwapArea::getAverageReadLatency() const {
+    return pagesIn ? readNanos / 1000.0 / pagesIn : 0.0;
+}
+
+void SwapArea::showStatus() const {
+    std::cout << "交换区: " << (slotCount - freeSlots) << "/" << slotCount << " 槽位已用" << std::endl;
+    std::cout << "换出: " << pagesOut << " 页 / " << writeOps << " 次写, 平均 "
+              << std::fixed << std::setprecision(2) << getAverageWriteLatency() << "us/页" << std::endl;
+    std::cout << "换入: " << pagesIn << " 页 / " << readOps << " 次读, 平均 "
+              << std::fixed << std::setprecision(2) << getAverageReadLatency() << "us/页" << std::endl;
+}
@@ -0,0 +1,72 @@
+#ifndef SWAPAREA_H
+#define SWAPAREA_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 交换区：宿主机上的一个文件，按页大小划分为槽位，通过 pread/pwrite 访问
+// 槽位用位图分配，批量换出时尽量分配连续槽位，使一批页面只需一次写操作
+// 未指定路径时在临时目录用 mkstemp 建一个唯一的文件并立即删除，多个模拟器实例互不覆盖
+class SwapArea {
+private:
+    struct SlotOwner {
+        int processId;        // 槽位中页面所属进程，-1 表示空闲
+        long long pageNumber; // 槽位中页面的逻辑页号
+    };
+
+    std::string path;
+    int fd;
+    bool anonymous;                // 打开后即已删除的临时文件
+    int slotCount;
+    int pageBytes;
+    int freeSlots;
+    int cursor;                    // 下一次查找空闲槽位的起点（循环首次适配）
+    std::vector<uint64_t> usedBitmap;
+    std::vector<SlotOwner> owners;
+
+    // 统计
+    long long pagesOut;
+    long long pagesIn;
+    long long writeOps;
+    long long readOps;
+    long long writeNanos;
+    long long readNanos;
+
+    bool slotUsed(int slot) const;
+    void markSlot(int slot, bool used);
+
+public:
+    // path 为空时使用匿名临时文件；指定的路径会被截断，由调用者保证不与其他实例共用
+    SwapArea(const std::string& path, int slotCount, int pageBytes);
+    ~SwapArea();
+
+    SwapArea(const SwapArea&) = delete;
+    SwapArea& operator=(const SwapArea&) = delete;
+
+    bool isOpen() const;
+
+    // 分配 count 个连续槽位，返回首槽号，没有足够长的连续空闲段返回 -1
+    int allocateSlots(int count);
+    void freeSlot(int slot);
+
+    void setSlotOwner(int slot, int processId, long long pageNumber);
+    bool getSlotOwner(int slot, int& processId, long long& pageNumber) const;
+
+    // 连续槽位的批量读写，各一次系统调用
+    bool writeSlots(int firstSlot, int count, const char* data);
+    bool readSlots(int firstSlot, int count, char* data);
+
+    int getSlotCount() const;
+    int getFreeSlots() const;
+    long long getPagesOut() const;
+    long long getPagesIn() const;
+
+    // 平均每页换出/换入耗时（微秒）
+    double getAverageWriteLatency() const;
+    double getAverageReadLatency() const;
+
+    void showStatus() const;
+};
+
+#endif // SWAPAREA_H
@@ -0,0 +1,108 @@
+#include "Tlb.h"
+#include <iostream>
+#include <iomanip>
+
+Tlb::Tlb(int capacity, int hugeOrder)
+    : capacity(capacity), hugeOrder(hugeOrder), hugeEntries(0), hits(0), misses(0), hugeHits(0) {}
+
+void Tlb::erase(const Key& key) {
+    auto it = index.find(key);
+    if (it == index.end()) return;
+    if (it->second->huge) hugeEntries--;
+    entries.erase(it->second);
+    index.erase(it);
+}
+
+int Tlb::lookup(int processId, long long pageNumber) {
+    // 先查覆盖该页的大页表项，再查基本页表项
+    if (hugeEntries > 0) {
+        auto it = index.find(Key{processId, pageNumber >> hugeOrder, true});
+        if (it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            hits++;
+            hugeHits++;
+            return it->second->frameNumber + (int)(pageNumber & ((1LL << hugeOrder) - 1));
+        }
+    }
+
+    auto it = index.find(Key{processId, pageNumber, false});
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        hits++;
+        return it->second->frameNumber;
+    }
+
+    misses++;
+    return -1;
+}
+
+void Tlb::insert(int processId, long long pageNumber, int frameNumber, bool huge) {
+    if (capacity <= 0) return;
+
+    Key key{processId, huge ? pageNumber >> hugeOrder : pageNumber, huge};
+    erase(key);
+
+    // 淘汰最久未使用的表项
+    if ((int)entries.size() >= capacity) {
+        const Entry& victim = entries.back();
+        erase(Key{victim.processId, victim.tag, victim.huge});
+    }
+
+    entries.push_front(Entry{processId, key.tag, huge, frameNumber});
+    index[key] = entries.begin();
+    if (huge) hugeEntries++;
+}
+
+void Tlb::invalidate(int processId, long long pageNumber) {
+    erase(Key{processId, pageNumber, false});
+    erase(Key{processId, pageNumber >> hugeOrder, true});
+}
+
+void Tlb::invalidateProcess(int processId) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto next = std::next(it);
+        if (it->processId == processId) {
+            erase(Key{it->processId, it->tag, it->huge});
+        }
+        it = next;
+    }
+}
+
+void Tlb::flush() {
+    entries.clear();
+    index.clear();
+    hugeEntries = 0;
+}
+
+void Tlb::setHugeOrder(int order) {
+    flush();
+    hugeOrder = order;
+}
+
+void Tlb::setCapacity(int entries) {
+    flush();
+    capacity = entries;
+}
+
+long long Tlb::getHits() const {
+    return hits;
+}
+
+long long Tlb::getMisses() const {
+    return misses;
+}
+
+double Tlb::getHitRate() const {
+    return hits + misses ? (double)hits / (hits + misses) : 0.0;
+}
+
+long long Tlb::getReachPages() const {
+    return (long long)(entries.size() - hugeEntries) + ((long long)hugeEntries << hugeOrder);
+}
+
+void Tlb::showStatus(int pageBytes) const {
+    std::cout << "TLB: " << entries.size() << "/" << capacity << " 项 (大页 " << hugeEntries
+              << " 项), 覆盖 " << getReachPages() * pageBytes / 1024 << "KB" << std::endl;
+    std::cout << "TLB 命中率: " << std::fixed << std::setprecision(2) << getHitRate() * 100
+              << "% (命中 " << hits << ", 其中大页 " << hugeHits << ", 未命中 " << misses << ")" << std::endl;
+}
@@ -0,0 +1,73 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+// 快表（TLB）：全相联、LRU 替换，同时缓存基本页和大页的翻译
+// 一个大页表项覆盖 2^hugeOrder 个基本页，TLB 覆盖范围（reach）随之扩大
+class Tlb {
+private:
+    struct Entry {
+        int processId;
+        long long tag;    // 基本页为逻辑页号，大页为逻辑页号 >> hugeOrder
+        bool huge;
+        int frameNumber;  // 基本页为页框号，大页为起始页框号
+    };
+
+    struct Key {
+        int processId;
+        long long tag;
+        bool huge;
+        bool operator==(const Key& other) const {
+            return processId == other.processId && tag == other.tag && huge == other.huge;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<long long>()((key.tag * 31 + key.processId) * 2 + key.huge);
+        }
+    };
+
+    int capacity;
+    int hugeOrder;
+    std::list<Entry> entries;  // 表头为最近使用
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    int hugeEntries;
+
+    long long hits;
+    long long misses;
+    long long hugeHits;
+
+    void erase(const Key& key);
+
+public:
+    Tlb(int capacity, int hugeOrder);
+
+    // 命中返回页框号，未命中返回 -1
+    int lookup(int processId, long long pageNumber);
+
+    // 缓存翻译；huge 为真时 frameNumber 为大页的起始页框
+    void insert(int processId, long long pageNumber, int frameNumber, bool huge);
+
+    // 使覆盖该页的基本页表项和大页表项失效
+    void invalidate(int processId, long long pageNumber);
+    void invalidateProcess(int processId);
+    void flush();
+
+    void setHugeOrder(int order);
+    void setCapacity(int entries);
+
+    long long getHits() const;
+    long long getMisses() const;
+    double getHitRate() const;
+
+    // 当前 TLB 表项覆盖的页数（基本页计）
+    long long getReachPages() const;
+
+    void showStatus(int pageBytes) const;
+};
+
+#endif // TLB_H
@@ -0,0 +1,225 @@
+#include "TraceReplay.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <set>
+#include <unordered_map>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord 必须是 16 字节");
+
+namespace {
+
+// (进程ID, 逻辑页号)
+struct PageKey {
+    int processId;
+    long long pageNumber;
+
+    bool operator==(const PageKey& other) const {
+        return processId == other.processId && pageNumber == other.pageNumber;
+    }
+    bool operator<(const PageKey& other) const {
+        return processId != other.processId ? processId < other.processId
+                                            : pageNumber < other.pageNumber;
+    }
+};
+
+struct PageKeyHash {
+    size_t operator()(const PageKey& key) const {
+        return std::hash<long long>()(key.pageNumber * 0x9E3779B97F4A7C15ULL + key.processId);
+    }
+};
+
+const uint64_t NEVER_USED = UINT64_MAX;  // 之后不再被访问
+
+} // namespace
+
+double ReplayResult::faultRate() const {
+    return references ? (double)faults / references : 0.0;
+}
+
+TraceReplay::TraceReplay(const std::string& path, int frameSize)
+    : path(path), fd(-1), records(nullptr), recordCount(0), mappedBytes(0), frameSize(frameSize) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "轨迹文件打开失败: " << path << std::endl;
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TraceRecord)) {
+        std::cout << "轨迹文件为空或无法读取: " << path << std::endl;
+        return;
+    }
+
+    recordCount = st.st_size / sizeof(TraceRecord);
+    mappedBytes = recordCount * sizeof(TraceRecord);
+    void* base = mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+        std::cout << "轨迹文件映射失败: " << path << std::endl;
+        recordCount = 0;
+        mappedBytes = 0;
+        return;
+    }
+    // 顺序扫描，让内核提前读入、及早回收已扫过的页
+    madvise(base, mappedBytes, MADV_SEQUENTIAL);
+    records = static_cast<const TraceRecord*>(base);
+}
+
+TraceReplay::~TraceReplay() {
+    if (records) {
+        munmap(const_cast<TraceRecord*>(records), mappedBytes);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool TraceReplay::isOpen() const {
+    return records != nullptr;
+}
+
+size_t TraceReplay::getRecordCount() const {
+    return recordCount;
+}
+
+ReplayResult TraceReplay::replay(ReplacementPolicy policy, int frames) {
+    static const char* names[] = {"FIFO", "LRU", "CLOCK"};
+    ReplayResult result{names[policy], 0, 0};
+    if (!records) return result;
+
+    // 倒排页表：页表开销只与页框数有关，适合任意稀疏的轨迹地址
+    PagingMemoryManager manager(frames, frameSize, INVERTED_PAGE_TABLE);
+    manager.setReplacementPolicy(policy);
+    manager.setVerbose(false);
+
+    for (size_t i = 0; i < recordCount; i++) {
+        const TraceRecord& record = records[i];
+        if (record.address < 0) continue;
+
+        if (!manager.accessMemory(record.processId, record.address, record.write != 0)) {
+            // 首次出现的页：按需保留后重新访问；首次出现的进程先建立空地址空间
+            long long pageStart = record.address - record.address % ((long long)frameSize * 1024);
+            if (!manager.reservePages(record.processId, pageStart, frameSize)) {
+                manager.allocateMemory(record.processId, 0);
+                manager.reservePages(record.processId, pageStart, frameSize);
+            }
+            manager.accessMemory(record.processId, record.address, record.write != 0);
+        }
+        result.references++;
+    }
+
+    result.faults = manager.getPageFaults();
+    return result;
+}
+
+ReplayResult TraceReplay::replayOptimal(int frames) {
+    ReplayResult result{"OPT", 0, 0};
+    if (!records) return result;
+
+    long long pageBytes = (long long)frameSize * 1024;
+
+    // 下次使用位置索引与轨迹等长，放在映射到磁盘的辅助文件中，由内核按需换出；
+    // 文件名唯一，创建后立即删除，同时回放同一轨迹的多个实例互不干扰，异常退出也不留下残余
+    std::string indexPath = path + ".next.XXXXXX";
+    std::vector<char> nameBuffer(indexPath.begin(), indexPath.end());
+    nameBuffer.push_back('\0');
+    int indexFd = mkstemp(nameBuffer.data());
+    if (indexFd < 0) {
+        std::cout << "OPT 索引文件创建失败: " << indexPath << std::endl;
+        return result;
+    }
+    indexPath = nameBuffer.data();
+    unlink(indexPath.c_str());
+    size_t indexBytes = recordCount * sizeof(uint64_t);
+    uint64_t* nextUse = nullptr;
+    if (ftruncate(indexFd, indexBytes) == 0) {
+        void* base = mmap(nullptr, indexBytes, PROT_READ | PROT_WRITE, MAP_SHARED, indexFd, 0);
+        if (base != MAP_FAILED) {
+            nextUse = static_cast<uint64_t*>(base);
+        }
+    }
+    if (!nextUse) {
+        std::cout << "OPT 索引文件映射失败: " << indexPath << std::endl;
+        close(indexFd);
+        return result;
+    }
+
+    // 一次逆向扫描：记录每个页最近一次（即下一次）出现的位置；与正向模拟一样跳过无效记录
+    {
+        std::unordered_map<PageKey, uint64_t, PageKeyHash> lastSeen;
+        for (size_t i = recordCount; i-- > 0;) {
+            if (records[i].address < 0) continue;
+            PageKey key{records[i].processId, records[i].address / pageBytes};
+            auto it = lastSeen.find(key);
+            if (it == lastSeen.end()) {
+                nextUse[i] = NEVER_USED;
+                lastSeen.emplace(key, i);
+            } else {
+                nextUse[i] = it->second;
+                it->second = i;
+            }
+        }
+    }
+
+    // 正向模拟：驻留集按下次使用位置排序，缺页时淘汰最晚才会再用的页
+    std::unordered_map<PageKey, uint64_t, PageKeyHash> resident;
+    std::set<std::pair<uint64_t, PageKey>> byNextUse;
+    for (size_t i = 0; i < recordCount; i++) {
+        if (records[i].address < 0) continue;
+        PageKey key{records[i].processId, records[i].address / pageBytes};
+        result.references++;
+
+        auto it = resident.find(key);
+        if (it != resident.end()) {
+            byNextUse.erase({it->second, key});
+            it->second = nextUse[i];
+            byNextUse.insert({nextUse[i], key});
+            continue;
+        }
+
+        result.faults++;
+        if ((int)resident.size() >= frames) {
+            auto victim = std::prev(byNextUse.end());
+            resident.erase(victim->second);
+            byNextUse.erase(victim);
+        }
+        resident.emplace(key, nextUse[i]);
+        byNextUse.insert({nextUse[i], key});
+    }
+
+    munmap(nextUse, indexBytes);
+    close(indexFd);
+    return result;
+}
+
+std::vector<ReplayResult> TraceReplay::replayAll(int frames) {
+    std::vector<ReplayResult> results;
+    results.push_back(replay(FIFO_REPLACEMENT, frames));
+    results.push_back(replay(LRU_REPLACEMENT, frames));
+    results.push_back(replay(CLOCK_REPLACEMENT, frames));
+    results.push_back(replayOptimal(frames));
+
+    long long optFaults = results.back().faults;
+    std::cout << "\n======== 轨迹回放结果 (" << frames << " 个页框) ========" << std::endl;
+    std::cout << "算法\t访问次数\t缺页次数\t缺页率\t相对OPT效率" << std::endl;
+    std::cout << "------------------------------------------------" << std::endl;
+    for (const ReplayResult& r : results) {
+        std::cout << r.policy << "\t" << r.references << "\t\t" << r.faults << "\t\t"
+                  << std::fixed << std::setprecision(2) << r.faultRate() * 100 << "%\t"
+                  << (r.faults ? (double)optFaults / r.faults * 100 : 100.0) << "%" << std::endl;
+    }
+    std::cout << "================================================\n" << std::endl;
+    return results;
+}
+
+bool TraceReplay::writeTrace(const std::string& path, const std::vector<TraceRecord>& records) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(TraceRecord));
+    return (bool)out;
+}
@@ -0,0 +1,59 @@
+#ifndef TRACEREPLAY_H
+#define TRACEREPLAY_H
+
+#include "PageMng.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 访存轨迹记录（二进制文件中按此格式连续存放，每条 16 字节）
+struct TraceRecord {
+    int32_t processId;
+    uint32_t write;    // 0 读，1 写
+    int64_t address;   // 逻辑地址（字节）
+};
+
+// 一次回放的结果
+struct ReplayResult {
+    std::string policy;
+    long long references;
+    long long faults;
+
+    double faultRate() const;
+};
+
+// 轨迹驱动的分页回放：以内存映射方式顺序读取轨迹文件，逐条送入 PagingMemoryManager，
+// 统计各置换算法的缺页率，并以 Belady 最优算法（OPT）作为下界
+class TraceReplay {
+private:
+    std::string path;
+    int fd;
+    const TraceRecord* records;
+    size_t recordCount;
+    size_t mappedBytes;
+    int frameSize;     // 页框大小(KB)
+
+public:
+    TraceReplay(const std::string& path, int frameSize = 4);
+    ~TraceReplay();
+
+    TraceReplay(const TraceReplay&) = delete;
+    TraceReplay& operator=(const TraceReplay&) = delete;
+
+    bool isOpen() const;
+    size_t getRecordCount() const;
+
+    // 用指定置换算法和页框数回放整个轨迹
+    ReplayResult replay(ReplacementPolicy policy, int frames);
+
+    // OPT：先一次逆向扫描建立“下次使用位置”索引（存于映射到磁盘的辅助文件中），再正向模拟
+    ReplayResult replayOptimal(int frames);
+
+    // 回放全部算法并输出对比表
+    std::vector<ReplayResult> replayAll(int frames);
+
+    // 将记录写成轨迹文件
+    static bool writeTrace(const std::string& path, const std::vector<TraceRecord>& records);
+};
+
+#endif // TRACEREPLAY_H
@@ -7,8 +7,12 @@ using namespace std;
 
 
 ProcessManager::ProcessManager() : readyHead(nullptr), blockedHead(nullptr), 
-                                   runningHead(nullptr), currentTime(0) {
+                                   runningHead(nullptr), suspendedHead(nullptr),
+                                   admissionQueueLimit(16), admissionPolicy(ADMIT_FIFO), admittedCount(0),
+                                   queuedAdmissions(0), totalAdmissionLatency(0), maxAdmissionLatency(0),
+                                   rejectedCount(0), currentTime(0) {
     pagingManager = new PagingMemoryManager(256, 4); // 假设有256个页框，每个4KB=>1G
+    pagingManager->enableSwap("", 4096);       // 16MB 交换区，允许超过物理内存的负载
     resourceManager = new ResourceManager(pagingManager);
 }
 
@@ -34,19 +38,64 @@ ProcessManager::~ProcessManager() {
         runningHead = runningHead->next;
         delete temp;
     }
+
+    while (suspendedHead) {
+        Process* temp = suspendedHead;
+        suspendedHead = suspendedHead->next;
+        delete temp;
+    }
+
+    for (AdmissionEntry& entry : admissionQueue) {
+        delete entry.proc;
+    }
+}
+
+// 进程号须是不超过 9 位的十进制数，内存管理按其数值区分进程；不合法返回 -1
+static int parsePid(const string& pid) {
+    if (pid.empty() || pid.size() > 9) {
+        return -1;
+    }
+    for (char c : pid) {
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+    }
+    return atoi(pid.c_str());
 }
 
 Process* ProcessManager::createProcess(int space, string pid, int runtime, int arrivaltime, int priority, int attribute, vector<string> pre) {
+    // 永远无法接纳的进程直接拒绝：排进队列后它会一直排在前面，挡住后来的所有进程
+    int numericPid = parsePid(pid);
+    if (numericPid < 0 || allProcs.count(pid) || !pagingManager->isAdmissible(numericPid, space)) {
+        rejectedCount++;
+        cout << "Process " << pid << " rejected: invalid or duplicate pid, or " << space
+             << "KB can never fit in memory" << endl;
+        return nullptr;
+    }
     Process* proc = new Process(space, pid, runtime, arrivaltime, priority, "new", attribute, pre);
-    allProcs[pid] = proc;
 
-    
-    // 调用分页管理器进行内存分配
-    if (!pagingManager->allocateMemory(atoi(pid.c_str()), space)) {
-        cout << "Memory allocation failed for process " << pid << endl;
-        // 这里可以需要中断
+    // 接纳控制：预留到内存即接纳，内存在进程首次运行时才提交；已有进程排队时新进程不插队
+    if (!admissionQueue.empty() || !tryAdmit(proc)) {
+        if (admissionQueue.size() >= admissionQueueLimit) {
+            rejectedCount++;
+            cout << "Process " << pid << " rejected: admission queue full ("
+                 << admissionQueueLimit << " waiting)" << endl;
+            delete proc;
+            return nullptr;
+        }
+        allProcs[pid] = proc;
+        proc->set_state("deferred");
+        proc->next = nullptr;
+        admissionQueue.push_back(AdmissionEntry{proc, currentTime});
+        cout << "Process " << pid << " queued for admission: needs " << space << "KB, working set "
+             << pagingManager->getTotalWorkingSet() << "/" << pagingManager->getTotalFrames()
+             << " frames, " << pagingManager->getReservedPages() << " pages reserved" << endl;
+        checkDeferredProcesses();  // 按策略它可能排在已有进程之前
+        return proc;
     }
-    
+    allProcs[pid] = proc;
+    admittedCount++;
+
     // 只有在到达时间小于等于当前时间时才加入ready队列
     if (arrivaltime <= currentTime) {
         proc->next = readyHead;
@@ -65,7 +114,8 @@ bool ProcessManager::scheduleProcess(Process* proc) {
     // 尝试为进程分配资源
     if (resourceManager->requestResources(proc)) {
         proc->set_state("running");
-        // 添加到运行队列
+        // 先从就绪队列摘下再链入运行队列，否则改写 next 会丢掉就绪队列中排在它后面的进程
+        removeFromReadyQueue(proc);
         proc->next = runningHead;
         runningHead = proc;
         return true;
@@ -128,6 +178,9 @@ void ProcessManager::handleTimeSlice() {
     }
 }
 void ProcessManager::checkArrivingProcesses() {
+    // 先接纳工作集允许的被推迟进程
+    checkDeferredProcesses();
+
     // 检查是否有进程在当前时间到达
     for (auto& pair : allProcs) {
         Process* proc = pair.second;
@@ -141,23 +194,143 @@ void ProcessManager::checkArrivingProcesses() {
     }
 }
 
-void ProcessManager::checkBlockedProcesses() {
-    Process* prev = nullptr;
-    Process* curr = blockedHead;
-    
-    while (curr) {
-        if (resourceManager->requestResources(curr)) {
-            // 资源现在可用，移动到就绪队列
-            if (prev) prev->next = curr->next;
-            else blockedHead = curr->next;
-            
-            Process* next = curr->next;
-            moveToReadyQueue(curr);
-            curr = next;
-        } else {
-            prev = curr;
-            curr = curr->next;
+bool ProcessManager::tryAdmit(Process* proc) {
+    return pagingManager->canAdmit(proc->get_space()) &&
+           pagingManager->reserveMemory(atoi(proc->get_pid().c_str()), proc->get_space());
+}
+
+size_t ProcessManager::nextAdmission() {
+    size_t best = 0;
+    for (size_t i = 1; i < admissionQueue.size(); i++) {
+        Process* curr = admissionQueue[i].proc;
+        Process* chosen = admissionQueue[best].proc;
+        // 严格比较：相同时保留先到的
+        if ((admissionPolicy == ADMIT_PRIORITY && curr->get_priority() > chosen->get_priority()) ||
+            (admissionPolicy == ADMIT_SMALLEST_FIRST && curr->get_space() < chosen->get_space())) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void ProcessManager::checkDeferredProcesses() {
+    // 按策略选出的进程放不下时后面的进程也不越过它，避免大进程被小进程持续插队
+    while (!admissionQueue.empty()) {
+        size_t index = nextAdmission();
+        AdmissionEntry entry = admissionQueue[index];
+        if (!tryAdmit(entry.proc)) {
+            break;
+        }
+        admissionQueue.erase(admissionQueue.begin() + index);
+
+        int latency = currentTime - entry.enqueueTime;
+        admittedCount++;
+        queuedAdmissions++;
+        totalAdmissionLatency += latency;
+        maxAdmissionLatency = max(maxAdmissionLatency, latency);
+        entry.proc->set_state("new");
+        cout << "Process " << entry.proc->get_pid() << " admitted at time " << currentTime
+             << " after waiting " << latency << endl;
+    }
+}
+
+void ProcessManager::setAdmissionPolicy(AdmissionPolicy policy) {
+    admissionPolicy = policy;
+}
+
+void ProcessManager::setAdmissionQueueLimit(int limit) {
+    admissionQueueLimit = (size_t)max(0, limit);
+}
+
+void ProcessManager::showAdmissionStatus() {
+    static const char* const policyNames[] = {"FIFO", "Priority", "Smallest-first"};
+    cout << "Admission (" << policyNames[admissionPolicy] << "): " << admissionQueue.size() << "/"
+         << admissionQueueLimit << " waiting, admitted " << admittedCount << " (" << queuedAdmissions
+         << " after queueing), rejected " << rejectedCount << ", latency avg "
+         << fixed << setprecision(1)
+         << (queuedAdmissions ? (double)totalAdmissionLatency / queuedAdmissions : 0.0)
+         << " max " << maxAdmissionLatency << ", reserved " << pagingManager->getReservedPages()
+         << " pages" << endl;
+}
+
+void ProcessManager::checkMemoryPressure() {
+    // 工作集之和超过物理页框：挂起优先级最低的就绪进程，直到不再抖动
+    while (pagingManager->isThrashing()) {
+        Process* victim = nullptr;
+        for (Process* curr = readyHead; curr; curr = curr->next) {
+            if (!victim || curr->get_priority() < victim->get_priority()) {
+                victim = curr;
+            }
         }
+        if (!victim) break;
+        cout << "Thrashing detected (working set " << pagingManager->getTotalWorkingSet()
+             << "/" << pagingManager->getTotalFrames() << "), suspending process "
+             << victim->get_pid() << endl;
+        suspendProcess(victim);
+    }
+
+    // 压力解除后按挂起顺序激活
+    while (suspendedHead && pagingManager->canAdmit(suspendedHead->get_space())) {
+        Process* proc = suspendedHead;
+        activateProcess(proc);
+        if (proc->get_state() == "suspended") break;
+    }
+}
+
+void ProcessManager::suspendProcess(Process* proc) {
+    removeFromReadyQueue(proc);
+    proc->set_state("suspended");
+
+    // 挂起即整体换出：有交换区时写入交换区，否则直接释放其页框；尚未运行的进程只持有预留，保留不动
+    int pid = atoi(proc->get_pid().c_str());
+    if (pagingManager->isSwapEnabled()) {
+        pagingManager->swapOutProcess(pid);
+    } else if (!pagingManager->cancelReservation(pid)) {
+        pagingManager->deallocateMemory(pid);
+    }
+
+    // 追加到挂起队列尾部，保持挂起顺序
+    proc->next = nullptr;
+    if (!suspendedHead) {
+        suspendedHead = proc;
+    } else {
+        Process* tail = suspendedHead;
+        while (tail->next) tail = tail->next;
+        tail->next = proc;
+    }
+}
+
+void ProcessManager::activateProcess(Process* proc) {
+    // 换出的页在访问时按需换入；没有交换区时重新预留，再次运行时提交
+    int pid = atoi(proc->get_pid().c_str());
+    if (pagingManager->isSwapEnabled()) {
+        pagingManager->resumeProcess(pid);
+    } else if (!pagingManager->reserveMemory(pid, proc->get_space())) {
+        return;  // 仍然放不下，保持挂起
+    }
+
+    Process* prev = nullptr;
+    Process* curr = suspendedHead;
+    while (curr && curr != proc) {
+        prev = curr;
+        curr = curr->next;
+    }
+    if (curr) {
+        if (prev) prev->next = curr->next;
+        else suspendedHead = curr->next;
+    }
+
+    cout << "Process " << proc->get_pid() << " activated at time " << currentTime << endl;
+    moveToReadyQueue(proc);
+}
+
+void ProcessManager::checkBlockedProcesses() {
+    // 资源归还时 ResourceManager 只唤醒需求能被满足的等待者，这里把它们移回就绪队列，由调度时再申请；
+    // 没有归还就没有唤醒，不再对每个阻塞进程重试分配
+    for (Process* proc : resourceManager->takeWokenProcesses()) {
+        removeFromBlockedQueue(proc);
+        cout << "Process " << proc->get_pid() << " woken up at time " << currentTime << endl;
+        moveToReadyQueue(proc);
     }
 }
 
@@ -228,7 +401,7 @@ Process* ProcessManager::selectProcess(int method) {
 }
 bool ProcessManager::hasNewProcesses() {
     for (auto& pair : allProcs) {
-        if (pair.second->get_state() == "new") {
+        if (pair.second->get_state() == "new" || pair.second->get_state() == "deferred") {
             return true;
         }
     }
@@ -250,8 +423,10 @@ void ProcessManager::runScheduler(int method) {
     while (hasProcesses()||hasNewProcesses()) {
         cout << "\n--- Step " << step++ << " ---" << endl;
         cout << "Current Time: " << currentTime << endl;
+        resourceManager->setTime(currentTime);
         
         checkArrivingProcesses(); // 检查是否有新进程到达
+        checkMemoryPressure();    // 抖动时挂起进程
         resourceManager->showResourceStatus();
         showSystemStatus();
         showResourceRequirements(); // 显示资源需求
@@ -275,6 +450,7 @@ void ProcessManager::runScheduler(int method) {
                 // 模拟进程运行
                 int runTime = selected->get_runtime();
                 currentTime += runTime;
+                resourceManager->setTime(currentTime);
                 
                 cout << "Process " << selected->get_pid() 
                      << " completed at time " << currentTime << endl;
@@ -298,7 +474,7 @@ void ProcessManager::runScheduler(int method) {
             }
         } else {
             // 没有就绪进程，只有阻塞进程
-            if (blockedHead|| hasNewProcesses()) {
+            if (blockedHead || suspendedHead || hasNewProcesses()) {
                 cout << "No ready processes, advancing time..." << endl;
                 currentTime++;
                 checkBlockedProcesses();
@@ -327,6 +503,7 @@ void ProcessManager::interactiveScheduler(int method) {
     
     while (readyHead || blockedHead) {
         cout << "\n--- Step " << step++ << " (Time: " << currentTime << ") ---" << endl;
+        resourceManager->setTime(currentTime);
         
         // 显示当前状态
         resourceManager->showResourceStatus();
@@ -358,6 +535,7 @@ void ProcessManager::interactiveScheduler(int method) {
                 // 模拟进程运行
                 int runTime = selected->get_runtime();
                 currentTime += runTime;
+                resourceManager->setTime(currentTime);
                 
                 cout << "Process " << selected->get_pid() 
                      << " completed at time " << currentTime << endl;
@@ -470,6 +648,29 @@ void ProcessManager::showSystemStatus() {
         }
     }
     
+    // 显示挂起队列
+    cout << "Suspended Queue: ";
+    if (!suspendedHead) {
+        cout << "(empty)";
+    } else {
+        for (Process* curr = suspendedHead; curr; curr = curr->next) {
+            cout << curr->get_pid() << " ";
+        }
+    }
+    cout << endl;
+    cout << "Admission Queue: ";
+    if (admissionQueue.empty()) {
+        cout << "(empty)";
+    } else {
+        for (AdmissionEntry& entry : admissionQueue) {
+            cout << entry.proc->get_pid() << " ";
+        }
+    }
+    cout << endl;
+    cout << "Working set " << pagingManager->getTotalWorkingSet() << "/" << pagingManager->getTotalFrames()
+         << " frames, " << pagingManager->getReservedPages() << " pages reserved" << endl;
+    showAdmissionStatus();
+    
     cout << "===================" << endl;
 }
 
@@ -478,6 +679,8 @@ void ProcessManager::showAll() {
     cout << "Current Time: " << currentTime << endl;
     showSystemStatus();
     resourceManager->showResourceStatus();
+    resourceManager->showWaitQueues();
+    resourceManager->showLockStatus();
     cout << "=============================" << endl;
 }
 
@@ -629,9 +832,16 @@ int ProcessManager::getProcessCount() {
         curr = curr->next;
     }
     
+    curr = suspendedHead;
+    while (curr) {
+        count++;
+        curr = curr->next;
+    }
+    
     return count;
 }
 
 bool ProcessManager::hasProcesses() {
-    return (readyHead != nullptr) || (blockedHead != nullptr) || (runningHead != nullptr);
+    return (readyHead != nullptr) || (blockedHead != nullptr) || (runningHead != nullptr)
+        || (suspendedHead != nullptr);
 }
\ No newline at end of file
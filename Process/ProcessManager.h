@@ -10,16 +10,41 @@
 
 using namespace std;
 
+// 接纳队列的出队顺序
+enum AdmissionPolicy {
+    ADMIT_FIFO = 0,            // 按到达顺序
+    ADMIT_PRIORITY = 1,        // 优先级高者先（同优先级按到达顺序）
+    ADMIT_SMALLEST_FIRST = 2   // 内存需求小者先，吞吐高但大进程可能长期等待
+};
+
 class ProcessManager {
 private:
+    // 等待接纳的进程及其入队时刻
+    struct AdmissionEntry {
+        Process* proc;
+        int enqueueTime;
+    };
+
     Process* readyHead;
     Process* blockedHead;
     Process* runningHead;
+    Process* suspendedHead;          // 因内存压力被挂起的进程
+    vector<AdmissionEntry> admissionQueue; // 内存预留不到而等待接纳的进程（按到达顺序）
+    size_t admissionQueueLimit;      // 队列满时拒绝新进程
+    AdmissionPolicy admissionPolicy;
+    int admittedCount;               // 接纳的进程数（含无需排队的）
+    int queuedAdmissions;            // 其中排过队的
+    long long totalAdmissionLatency; // 排队进程的等待时间之和
+    int maxAdmissionLatency;
+    int rejectedCount;               // 被拒绝的进程数：队列满，或进程号无效、重复，或内存永远放不下
     map<string, Process*> allProcs;
     int currentTime;
     ResourceManager* resourceManager;
     PagingMemoryManager* pagingManager;
 
+    bool tryAdmit(Process* proc);    // 工作集允许且预留内存成功即接纳
+    size_t nextAdmission();          // 按接纳策略选出的队列下标
+
 public:
     ProcessManager();
     ~ProcessManager();
@@ -45,6 +70,13 @@ public:
     void moveToReadyQueue(Process* proc);
     void checkBlockedProcesses();
     void checkArrivingProcesses();
+    void checkDeferredProcesses();   // 内存允许时按接纳策略接纳排队的进程
+    void checkMemoryPressure();      // 抖动时挂起进程，压力解除后激活
+
+    // 接纳控制：进程创建时预留内存，首次运行时提交；预留不到时进入有界的接纳队列等待
+    void setAdmissionPolicy(AdmissionPolicy policy);
+    void setAdmissionQueueLimit(int limit);
+    void showAdmissionStatus();
 
     // 资源管理
     void releaseProcessResources(Process* proc);
@@ -1,168 +1,1165 @@
 #include "ResourceManager.h"
 #include "Semaphore.h"
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 map<string, Semaphore*> SystemSemaphores;
-ResourceManager::ResourceManager(PagingMemoryManager* pm) : pagingManager(pm) {
+
+static const int MAX_PROCESS_ID = 1 << 20;  // 与分页管理器的进程号上限一致
+ResourceManager::ResourceManager(PagingMemoryManager* pm)
+    : resourceCount(0), cpuId(-1), diskId(-1), printerId(-1), pagingManager(pm), avoidanceEnabled(false), safetyChecks(0), sequenceHits(0),
+      sequenceRebuilds(0), unsafeDenials(0), wakeupOrder(WAKE_FIFO), nextTicket(0), wakeups(0), requeues(0),
+      rollbacks(0), inheritanceEnabled(true), clock(0), boosts(0), longestBoostChain(0), inversions(0),
+      totalInversionTime(0), longestInversion(0) {
     initializeResources();
+    waitGraph.setDeadlockHandler([this](const vector<Process*>& deadlocked) { resolveDeadlock(deadlocked); });
 }
 
 ResourceManager::~ResourceManager() {
-    for (auto& pair : resources) {
+    for (auto& pair : SystemSemaphores) {
         delete pair.second;
     }
-    resources.clear();
+    SystemSemaphores.clear();
 }
 
 void ResourceManager::initializeResources() {
-    resources["CPU"] = new Resource(2, "CPU");
-    resources["Memory"] = new Resource(1024, "Memory");
-    resources["Disk"] = new Resource(1, "Disk");
-    resources["Printer"] = new Resource(1, "Printer");
+    total.fill(0);
+    available.fill(0);
+    promised.fill(0);
+    graphIds.fill(-1);
+    cpuId = registerResource("CPU", 2);
+    registerResource("Memory", 1024);
+    diskId = registerResource("Disk", 1);
+    printerId = registerResource("Printer", 1);
 }
-bool ResourceManager::handleMemoryShortage(Process* process) {
-    cout << "ResourceManager: 内存不足，尝试页置换操作..." << endl;
-    
-    // 查找可以换出的进程（LRU算法）
-    Process* victimProcess = findLRUProcess();
-    if (victimProcess) {
-        // 将victim进程换出到磁盘
-        swapOut(victimProcess);
-        
-        // 尝试为新进程分配内存
-        if (pagingManager->allocateMemory(stoi(process->get_pid()), process->get_space())) {
-            cout << "ResourceManager: 换页成功，为进程 " << process->get_pid() << " 分配内存" << endl;
-            return true;
+
+int ResourceManager::registerResource(const string& name, int amount) {
+    auto it = resourceIndex.find(name);
+    if (it != resourceIndex.end()) {
+        return it->second;
+    }
+    if (resourceCount == MAX_RESOURCES) {
+        cout << "ResourceManager: 资源种类超过 " << MAX_RESOURCES << "，忽略 " << name << endl;
+        return -1;
+    }
+    int id = resourceCount++;
+    total[id] = amount;
+    available[id] = amount;
+    resourceNames.push_back(name);
+    resourceIndex[name] = id;
+    graphIds[id] = waitGraph.resourceId(name);
+    waitGraph.setAvailable(graphIds[id], amount);
+    return id;
+}
+
+int ResourceManager::getResourceId(const string& name) const {
+    auto it = resourceIndex.find(name);
+    return it == resourceIndex.end() ? -1 : it->second;
+}
+
+int ResourceManager::pidIndex(const string& pid) {
+    if (pid.empty() || pid.size() > 7) {
+        return -1;
+    }
+    int index = 0;
+    for (char c : pid) {
+        if (c < '0' || c > '9') {
+            return -1;
         }
+        index = index * 10 + (c - '0');
     }
-    
-    return false;
+    return index <= MAX_PROCESS_ID ? index : -1;
+}
+
+ResourceManager::ResourceVector& ResourceManager::heldBy(int index) {
+    if (index >= (int)processResources.size()) {
+        processResources.resize(index + 1, ResourceVector());
+    }
+    return processResources[index];
+}
+
+int ResourceManager::claimOf(int index) const {
+    return index < (int)claimSlots.size() ? claimSlots[index] : -1;
 }
 
+bool ResourceManager::fits(const ResourceVector& need, const ResourceVector& have) {
+    int over = 0;
+    for (int j = 0; j < MAX_RESOURCES; j++) {
+        over |= need[j] > have[j];
+    }
+    return over == 0;
+}
+
+ResourceManager::ResourceVector ResourceManager::demandOf(Process* process) {
+    ResourceVector required;
+    required.fill(0);
+    // 所有进程都需要CPU
+    required[cpuId] = 1;
+
+    // // 根据内存需求
+    // if (process->get_space() > 0) {
+    //     required[memoryId] = process->get_space();
+    // }
+
+    // 根据属性决定其他资源
+    if (process->get_attribute() == 1) {
+        required[diskId] = 1;
+    }
+    if (process->get_attribute() == 2) {
+        required[printerId] = 1;
+    }
+    return required;
+}
 void ResourceManager::addToWaitingQueue(Process* process, const string& resourceName) {
     // 将进程加入资源等待队列
     if (SystemSemaphores.find(resourceName) != SystemSemaphores.end()) {
         SystemSemaphores[resourceName]->P(process);
+        return;
+    }
+    int id = getResourceId(resourceName);
+    if (id != -1) {
+        enqueueWaiter(process, demandOf(process), id);
+    }
+}
+
+int ResourceManager::firstLacking(const ResourceVector& demand, const ResourceVector& have) const {
+    for (int j = 0; j < resourceCount; j++) {
+        if (demand[j] > have[j]) {
+            return j;
+        }
+    }
+    return -1;
+}
+
+bool ResourceManager::waitsBefore(const Waiter& a, const Waiter& b) const {
+    if (wakeupOrder == WAKE_PRIORITY && a.process->get_priority() != b.process->get_priority()) {
+        return a.process->get_priority() > b.process->get_priority();
+    }
+    return a.ticket < b.ticket;
+}
+
+void ResourceManager::insertWaiter(deque<Waiter>& queue, const Waiter& waiter) {
+    // 新阻塞的进程 ticket 最大，FIFO 下总是追加在队尾；只有转队或按优先级时才需要找位置
+    auto pos = upper_bound(queue.begin(), queue.end(), waiter,
+                           [this](const Waiter& a, const Waiter& b) { return waitsBefore(a, b); });
+    queue.insert(pos, waiter);
+}
+
+void ResourceManager::enqueueWaiter(Process* process, const ResourceVector& demand, int id) {
+    // 重试仍失败时按当前缺的资源重新排队，保留第一次阻塞的 ticket
+    cancelWaiter(process);
+    auto ticket = waitTickets.emplace(process->get_pid(), nextTicket);
+    if (ticket.second) {
+        nextTicket++;
+    }
+    Waiter waiter = {process, demand, ticket.first->second};
+    insertWaiter(id == -1 ? retryWaiters : waitQueues[id], waiter);
+    queuedOn[process->get_pid()] = id;
+}
+
+void ResourceManager::cancelWaiter(Process* process) {
+    auto it = queuedOn.find(process->get_pid());
+    if (it != queuedOn.end()) {
+        deque<Waiter>& queue = it->second == -1 ? retryWaiters : waitQueues[it->second];
+        for (auto w = queue.begin(); w != queue.end(); ++w) {
+            if (w->process == process) {
+                queue.erase(w);
+                break;
+            }
+        }
+        queuedOn.erase(it);
+    }
+    wokenProcesses.erase(remove(wokenProcesses.begin(), wokenProcesses.end(), process), wokenProcesses.end());
+    dropPromise(process->get_pid());
+}
+
+void ResourceManager::dropPromise(const string& pid) {
+    auto it = promises.find(pid);
+    if (it == promises.end()) {
+        return;
+    }
+    for (int j = 0; j < MAX_RESOURCES; j++) {
+        promised[j] -= it->second[j];
+    }
+    promises.erase(it);
+}
+
+void ResourceManager::wakeWaiters(int id) {
+    // 按队列顺序检查，已唤醒者（包括之前唤醒、还没重新申请的）的需求从可用量中预先扣除，
+    // 避免唤醒超过归还量的进程
+    ResourceVector projected;
+    for (int j = 0; j < MAX_RESOURCES; j++) {
+        projected[j] = available[j] - promised[j];
+    }
+    deque<Waiter>& queue = waitQueues[id];
+    for (auto it = queue.begin(); it != queue.end() && projected[id] > 0;) {
+        int lacking = firstLacking(it->demand, projected);
+        if (lacking == id) {
+            ++it;  // 需要的比现在空出的多，留在原位
+            continue;
+        }
+        Waiter waiter = *it;
+        it = queue.erase(it);
+        if (lacking == -1) {
+            for (int j = 0; j < MAX_RESOURCES; j++) {
+                projected[j] -= waiter.demand[j];
+                promised[j] += waiter.demand[j];
+            }
+            promises[waiter.process->get_pid()] = waiter.demand;
+            queuedOn.erase(waiter.process->get_pid());
+            wokenProcesses.push_back(waiter.process);
+            wakeups++;
+        } else {
+            insertWaiter(waitQueues[lacking], waiter);
+            queuedOn[waiter.process->get_pid()] = lacking;
+            requeues++;
+        }
+    }
+
+    // 这些进程被拒绝的原因与单个资源无关，任何归还都可能让它们通过
+    while (!retryWaiters.empty()) {
+        Process* process = retryWaiters.front().process;
+        retryWaiters.pop_front();
+        queuedOn.erase(process->get_pid());
+        wokenProcesses.push_back(process);
+        wakeups++;
+    }
+}
+
+vector<Process*> ResourceManager::takeWokenProcesses() {
+    vector<Process*> woken;
+    woken.swap(wokenProcesses);
+    return woken;
+}
+
+void ResourceManager::setWakeupOrder(WakeupOrder order) {
+    wakeupOrder = order;
+    auto before = [this](const Waiter& a, const Waiter& b) { return waitsBefore(a, b); };
+    for (int j = 0; j < resourceCount; j++) {
+        stable_sort(waitQueues[j].begin(), waitQueues[j].end(), before);
+    }
+    stable_sort(retryWaiters.begin(), retryWaiters.end(), before);
+}
+
+void ResourceManager::showWaitQueues() {
+    cout << "等待队列 (" << (wakeupOrder == WAKE_FIFO ? "FIFO" : "优先级") << "): 唤醒 " << wakeups
+         << " 次, 转队 " << requeues << " 次" << endl;
+    for (int j = 0; j < resourceCount; j++) {
+        if (waitQueues[j].empty()) continue;
+        cout << "  " << resourceNames[j] << ":";
+        for (const Waiter& waiter : waitQueues[j]) {
+            cout << " " << waiter.process->get_pid();
+        }
+        cout << endl;
+    }
+    if (!retryWaiters.empty()) {
+        cout << "  待重试:";
+        for (const Waiter& waiter : retryWaiters) {
+            cout << " " << waiter.process->get_pid();
+        }
+        cout << endl;
     }
 }
 
 bool ResourceManager::requestResources(Process* process) {
-    vector<string> requiredResources;
-    vector<int> requiredAmounts;
     if (!process) {
         std::cout << "ResourceManager: 进程指针为空" << std::endl;
         return false;
     }
     std::cout << "ResourceManager: 进程 " << process->get_pid() 
               << " 请求资源分配" << std::endl;
-    if (process->get_space() > 0) {
-        std::cout << "ResourceManager: 为进程 " << process->get_pid() 
+    int pid = pidIndex(process->get_pid());
+    if (pid == -1) {
+        std::cout << "ResourceManager: 进程号 " << process->get_pid() << " 无效" << std::endl;
+        return false;
+    }
+    ResourceVector required = demandOf(process);
+    dropPromise(process->get_pid());
+    
+    // 检查所有资源是否可用，开启死锁避免时还要求分配后仍处于安全状态
+    if (!canGrant(process->get_pid(), pid, required)) {
+        recordWaits(process, required);
+        enqueueWaiter(process, required, firstLacking(required, available));
+        return false;
+    }
+    
+    // 内存在接纳时已预留，首次运行时提交；再次调度（如阻塞后重试）时已分配，不重复分配
+    // 未经接纳控制创建的进程没有预留，直接分配
+    if (process->get_space() > 0 && !pagingManager->isAllocated(pid)) {
+        bool committed = pagingManager->hasReservation(pid)
+                             ? pagingManager->commitMemory(pid)
+                             : pagingManager->allocateMemory(pid, process->get_space());
+        if (!committed) {
+            std::cout << "ResourceManager: 进程 " << process->get_pid() << " 内存提交失败" << std::endl;
+            enqueueWaiter(process, required, -1);
+            return false;
+        }
+        std::cout << "ResourceManager: 为进程 " << process->get_pid()
                   << " 分配内存 " << process->get_space() << "KB" << std::endl;
-        if (!pagingManager->allocateMemory(stoi(process->get_pid()), process->get_space())) {
-            std::cout << "ResourceManager: 内存分配失败，尝试换页操作..." << std::endl;
-            return false; // 
-            // 内存不足时的处理策略
-            if (handleMemoryShortage(process)) {
-                // 再次尝试分配
-                if (pagingManager->allocateMemory(std::stoi(process->get_pid()), process->get_space())) {
-                    std::cout << "ResourceManager: 换页后内存分配成功" << std::endl;
-                } else {
-                    std::cout << "ResourceManager: 换页后仍无法分配内存，进程进入等待状态" << std::endl;
-                    addToWaitingQueue(process, "Memory");
-                    return false;
-                }
-            } else {
-                std::cout << "ResourceManager: 换页操作失败，进程进入等待状态" << std::endl;
-                addToWaitingQueue(process, "Memory");
-                return false;
+    }
+
+    // 分配资源
+    applyGrant(process, pid, required);
+    return true;
+}
+
+bool ResourceManager::requestResources(Process* process, const map<string, int>& request) {
+    ResourceVector amounts;
+    if (!toVector(request, amounts)) {
+        return false;
+    }
+    return requestResources(process, amounts);
+}
+
+bool ResourceManager::requestResources(Process* process, const ResourceVector& request) {
+    int index = process ? pidIndex(process->get_pid()) : -1;
+    if (index == -1) {
+        return false;
+    }
+    if (!canGrant(process->get_pid(), index, request)) {
+        recordWaits(process, request);
+        return false;
+    }
+    applyGrant(process, index, request);
+    return true;
+}
+
+void ResourceManager::recordWaits(Process* process, const ResourceVector& request) {
+    // 只有可用量不足的资源构成等待；因不安全被拒绝时资源其实可用，不会参与死锁
+    // 重试时等待的资源可能变了：先去掉已不缺的资源（信号量上的等待不在这里管），再登记缺的
+    for (int j = 0; j < resourceCount; j++) {
+        if (request[j] <= available[j]) {
+            waitGraph.removeWaiter(graphIds[j], process);
+        }
+    }
+    for (int j = 0; j < resourceCount; j++) {
+        if (request[j] > available[j]) {
+            waitGraph.addWaiter(graphIds[j], process, request[j]);
+        }
+    }
+}
+
+bool ResourceManager::canGrant(const string& pid, int index, const ResourceVector& request) {
+    if (!fits(request, available)) {
+        return false; // 资源不足
+    }
+    if (!avoidanceEnabled) {
+        return true;
+    }
+
+    int slot = claimOf(index);
+    if (slot == -1) {
+        // 未声明最大需求时以第一次请求作为最大需求
+        if (!declareMaxClaim(pid, request)) {
+            return false;
+        }
+        slot = claimOf(index);
+    }
+    return isSafeGrant(slot, request);
+}
+
+void ResourceManager::applyGrant(Process* process, int index, const ResourceVector& request) {
+    ResourceVector& held = heldBy(index);
+    int claim = claimOf(index);
+    cancelWaiter(process);
+    waitTickets.erase(process->get_pid());
+    for (int j = 0; j < resourceCount; j++) {
+        waitGraph.removeWaiter(graphIds[j], process);
+    }
+    for (int j = 0; j < resourceCount; j++) {
+        if (request[j] > 0 && allocateResource(process, j, request[j])) {
+            held[j] += request[j];
+            waitGraph.addHolder(graphIds[j], process, request[j]);
+            if (avoidanceEnabled && claim != -1) {
+                claims[claim].allocated[j] += request[j];
             }
         }
     }
+}
+
+void ResourceManager::releaseResources(Process* process) {
+    string pid = process->get_pid();
+    int index = pidIndex(pid);
+    // 尚未运行过的进程只持有预留
+    if (index != -1 && !pagingManager->cancelReservation(index)) {
+        pagingManager->deallocateMemory(index);
+    }
     
-    // 所有进程都需要CPU
-    requiredResources.push_back("CPU");
-    requiredAmounts.push_back(1);
-    
-    // // 根据内存需求
-    // if (process->get_space() > 0) {
-    //     requiredResources.push_back("Memory");
-    //     requiredAmounts.push_back(process->get_space());
-    // }
-    
-    // 根据属性决定其他资源
-    if (process->get_attribute() == 1) {
-        requiredResources.push_back("Disk");
-        requiredAmounts.push_back(1);
+    cancelWaiter(process);
+    waitTickets.erase(pid);
+    releaseHoldings(process);
+    if (index != -1) {
+        retireClaim(index);
     }
-    if (process->get_attribute() == 2) {
-        requiredResources.push_back("Printer");
-        requiredAmounts.push_back(1);
+}
+
+void ResourceManager::releaseHoldings(Process* process) {
+    string pid = process->get_pid();
+    // 撤销等待、归还持有都会修改等待图，先各取一份
+    map<int, int> waiting = waitGraph.getWaits(pid);
+    for (auto& pair : waiting) {
+        const string& name = waitGraph.getResourceName(pair.first);
+        auto sem = SystemSemaphores.find(name);
+        if (sem != SystemSemaphores.end()) {
+            sem->second->cancelWait(process);
+        }
+        if (locks.count(name)) {
+            cancelLockWait(process);
+        }
     }
-    
-    // 检查所有资源是否可用
-    for (int i = 0; i < requiredResources.size(); i++) {
-        string resourceName = requiredResources[i];
-        int amount = requiredAmounts[i];
-        
-        if (resources[resourceName]->available < amount) {
-            return false; // 资源不足
+    waitGraph.clearWaits(process);
+
+    int index = pidIndex(pid);
+    if (index != -1 && index < (int)processResources.size()) {
+        ResourceVector& held = processResources[index];
+        for (int j = 0; j < resourceCount; j++) {
+            if (held[j] > 0) {
+                freeResource(process, j, held[j]);
+                waitGraph.removeHolder(graphIds[j], process, held[j]);
+            }
         }
+        held.fill(0);
     }
-    
-    // 分配资源
-    vector<string> allocatedResources;
-    for (int i = 0; i < requiredResources.size(); i++) {
-        string resourceName = requiredResources[i];
-        int amount = requiredAmounts[i];
-        
-        if (allocateResource(process, resourceName, amount)) {
-            allocatedResources.push_back(resourceName);
+    // 归还资源不会使安全序列失效
+    int claim = index == -1 ? -1 : claimOf(index);
+    if (claim != -1) {
+        claims[claim].allocated.fill(0);
+    }
+
+    // 剩下的持有都是信号量和锁；归还时可能唤醒等待者
+    map<int, int> owned = waitGraph.getHoldings(pid);
+    for (auto& pair : owned) {
+        const string& name = waitGraph.getResourceName(pair.first);
+        auto sem = SystemSemaphores.find(name);
+        for (int i = 0; sem != SystemSemaphores.end() && i < pair.second; i++) {
+            sem->second->V(process);
+        }
+        if (locks.count(name)) {
+            unlock(process, name);
         }
     }
-    
-    processResources[process->get_pid()] = allocatedResources;
+    waitGraph.removeProcess(process);
+}
+
+Semaphore* ResourceManager::createSemaphore(const string& name, int value) {
+    if (SystemSemaphores.count(name) || locks.count(name)) {
+        return nullptr;
+    }
+    Semaphore* sem = new Semaphore(value, name, &waitGraph);
+    SystemSemaphores[name] = sem;
+    return sem;
+}
+
+Process* ResourceManager::chooseVictim(const vector<Process*>& deadlocked) {
+    // 回滚代价按持有的资源单位数计，代价相同时牺牲优先级低的
+    Process* victim = nullptr;
+    int victimCost = 0;
+    for (Process* process : deadlocked) {
+        int cost = 0;
+        for (auto& pair : waitGraph.getHoldings(process->get_pid())) {
+            cost += pair.second;
+        }
+        if (!victim || cost < victimCost ||
+            (cost == victimCost && process->get_priority() < victim->get_priority())) {
+            victim = process;
+            victimCost = cost;
+        }
+    }
+    return victim;
+}
+
+void ResourceManager::resolveDeadlock(const vector<Process*>& deadlocked) {
+    Process* victim = chooseVictim(deadlocked);
+    cout << "ResourceManager: 检测到死锁，涉及进程";
+    for (Process* process : deadlocked) {
+        cout << " " << process->get_pid();
+    }
+    cout << "，回滚进程 " << victim->get_pid() << endl;
+    rollbackProcess(victim);
+}
+
+void ResourceManager::rollbackProcess(Process* process) {
+    // 在信号量或锁上等待的进程被撤销等待后没人会唤醒它，置为就绪让它重新申请；
+    // 在资源上等待的进程仍在等待队列中，占用的资源归还后会被唤醒重试
+    bool semaphoreWait = false;
+    for (auto& pair : waitGraph.getWaits(process->get_pid())) {
+        const string& name = waitGraph.getResourceName(pair.first);
+        semaphoreWait = semaphoreWait || SystemSemaphores.count(name) || locks.count(name);
+    }
+    releaseHoldings(process);
+    if (semaphoreWait) {
+        process->set_state("ready");
+    }
+    rollbacks++;
+}
+
+void ResourceManager::showDeadlockStatus() {
+    cout << "死锁检测: 发现死锁 " << waitGraph.getDeadlockCount() << " 次, 回滚进程 " << rollbacks << " 次" << endl;
+    waitGraph.showStatus();
+}
+
+bool ResourceManager::createMutex(const string& name) {
+    return createLock(name, false);
+}
+
+bool ResourceManager::createRWLock(const string& name) {
+    return createLock(name, true);
+}
+
+bool ResourceManager::createLock(const string& name, bool readWrite) {
+    if (locks.count(name) || SystemSemaphores.count(name) || resourceIndex.count(name)) {
+        cout << "ResourceManager: 名称 " << name << " 已被使用，不能创建锁" << endl;
+        return false;
+    }
+    KernelLock lock;
+    lock.readWrite = readWrite;
+    lock.writer = nullptr;
+    lock.acquisitions = 0;
+    lock.contentions = 0;
+    lock.graphId = waitGraph.resourceId(name);
+    locks[name] = lock;
+    waitGraph.setAvailable(lock.graphId, freeLockUnits(lock));
     return true;
 }
 
-void ResourceManager::releaseResources(Process* process) {
+int ResourceManager::lockUnits(const KernelLock& lock, bool exclusive) const {
+    return lock.readWrite && exclusive ? RWLOCK_UNITS : 1;
+}
+
+int ResourceManager::freeLockUnits(const KernelLock& lock) const {
+    if (lock.writer) {
+        return 0;
+    }
+    return lockUnits(lock, true) - (int)lock.readers.size();
+}
+
+vector<Process*> ResourceManager::lockHolders(const KernelLock& lock) const {
+    vector<Process*> holders(lock.readers);
+    if (lock.writer) {
+        holders.push_back(lock.writer);
+    }
+    return holders;
+}
+
+bool ResourceManager::lockMutex(Process* process, const string& name) {
+    auto it = locks.find(name);
+    if (it == locks.end() || it->second.readWrite) {
+        cout << "ResourceManager: 互斥锁 " << name << " 不存在" << endl;
+        return false;
+    }
+    return acquireLock(process, name, true);
+}
+
+bool ResourceManager::readLock(Process* process, const string& name) {
+    auto it = locks.find(name);
+    if (it == locks.end() || !it->second.readWrite) {
+        cout << "ResourceManager: 读写锁 " << name << " 不存在" << endl;
+        return false;
+    }
+    return acquireLock(process, name, false);
+}
+
+bool ResourceManager::writeLock(Process* process, const string& name) {
+    auto it = locks.find(name);
+    if (it == locks.end() || !it->second.readWrite) {
+        cout << "ResourceManager: 读写锁 " << name << " 不存在" << endl;
+        return false;
+    }
+    return acquireLock(process, name, true);
+}
+
+bool ResourceManager::acquireLock(Process* process, const string& name, bool exclusive) {
     string pid = process->get_pid();
-    pagingManager->deallocateMemory(stoi(process->get_pid()));
-    
-    if (processResources.find(pid) != processResources.end()) {
-        for (const string& resourceName : processResources[pid]) {
-            freeResource(process, resourceName);
+    auto held = heldLocks.find(pid);
+    if ((held != heldLocks.end() && held->second.count(name)) || lockWaits.count(pid)) {
+        cout << "ResourceManager: 进程 " << pid << " 已持有锁 " << name << " 或正在等待其他锁" << endl;
+        return false;
+    }
+
+    // 有进程排队时新来的也排队，锁按优先级交给排在最前的
+    KernelLock& lock = locks[name];
+    if (lock.waiters.empty() && !lock.writer && (!exclusive || lock.readers.empty())) {
+        grantLock(name, process, exclusive);
+        cout << "Process " << pid << " acquired lock " << name << endl;
+        return true;
+    }
+
+    LockWaiter waiter = {process, exclusive, nextTicket++, clock, -1};
+    insertLockWaiter(lock, waiter);
+    lockWaits[pid] = name;
+    lock.contentions++;
+    process->set_state("blocked");
+    cout << "Process " << pid << " blocked waiting for lock " << name << endl;
+    propagatePriority(name);
+    updateInversions(name);
+    // 最后登记到等待图：可能检测到死锁并回滚某个进程（也可能是它自己），锁的状态随之改变
+    waitGraph.addWaiter(lock.graphId, process, lockUnits(lock, exclusive));
+    return false;
+}
+
+void ResourceManager::grantLock(const string& name, Process* process, bool exclusive) {
+    KernelLock& lock = locks[name];
+    if (exclusive) {
+        lock.writer = process;
+    } else {
+        lock.readers.push_back(process);
+    }
+    heldLocks[process->get_pid()].insert(name);
+    lock.acquisitions++;
+    waitGraph.setAvailable(lock.graphId, freeLockUnits(lock));
+    waitGraph.addHolder(lock.graphId, process, lockUnits(lock, exclusive));
+}
+
+void ResourceManager::unlock(Process* process, const string& name) {
+    string pid = process->get_pid();
+    auto it = locks.find(name);
+    auto held = heldLocks.find(pid);
+    if (it == locks.end() || held == heldLocks.end() || !held->second.count(name)) {
+        cout << "ResourceManager: 进程 " << pid << " 未持有锁 " << name << endl;
+        return;
+    }
+    KernelLock& lock = it->second;
+    bool exclusive = lock.writer == process;
+    if (exclusive) {
+        lock.writer = nullptr;
+    } else {
+        lock.readers.erase(remove(lock.readers.begin(), lock.readers.end(), process), lock.readers.end());
+    }
+    held->second.erase(name);
+    if (held->second.empty()) {
+        heldLocks.erase(held);
+    }
+    waitGraph.removeHolder(lock.graphId, process, lockUnits(lock, exclusive));
+    waitGraph.setAvailable(lock.graphId, freeLockUnits(lock));
+    cout << "Process " << pid << " released lock " << name << endl;
+
+    // 不再因这把锁的等待者而提升；它自己还在等别的锁时（回滚途中）沿链传递回落
+    if (updatePriority(process)) {
+        auto waiting = lockWaits.find(pid);
+        if (waiting != lockWaits.end()) {
+            propagatePriority(waiting->second);
         }
-        processResources.erase(pid);
     }
+    grantLockWaiters(name);
 }
 
-bool ResourceManager::allocateResource(Process* process, const string& resourceName, int amount) {
-    if (resources.find(resourceName) != resources.end()) {
-        if (resources[resourceName]->available >= amount) {
-            resources[resourceName]->available -= amount;
-            cout << "Allocated " << amount << " " << resourceName 
-                 << " to process " << process->get_pid() << endl;
-            return true;
+void ResourceManager::grantLockWaiters(const string& name) {
+    // 写者只在锁完全空出时获得；读者在没有写者持有时获得，遇到排队的写者为止
+    KernelLock& lock = locks[name];
+    vector<Process*> granted;
+    while (!lock.waiters.empty()) {
+        LockWaiter waiter = lock.waiters.front();
+        if (lock.writer || (waiter.exclusive && !lock.readers.empty())) {
+            break;
+        }
+        granted.push_back(waiter.process);
+        lock.waiters.erase(lock.waiters.begin());
+        lockWaits.erase(waiter.process->get_pid());
+        endInversion(waiter);
+        waitGraph.removeWaiter(lock.graphId, waiter.process);
+        grantLock(name, waiter.process, waiter.exclusive);
+        waiter.process->set_state("ready");
+        cout << "Process " << waiter.process->get_pid() << " acquired lock " << name << " after waiting "
+             << clock - waiter.since << endl;
+    }
+    // 持有者变了或排在最前的等待者变了，都要重新计算继承的优先级；
+    // 获得锁的进程不再等待，经过它的链在它持有的锁处断开
+    propagatePriority(name);
+    updateInversions(name);
+    for (Process* process : granted) {
+        updateHeldInversions(process);
+    }
+}
+
+void ResourceManager::cancelLockWait(Process* process) {
+    auto it = lockWaits.find(process->get_pid());
+    if (it == lockWaits.end()) {
+        return;
+    }
+    string name = it->second;
+    lockWaits.erase(it);
+    KernelLock& lock = locks[name];
+    vector<LockWaiter>& waiters = lock.waiters;
+    for (auto w = waiters.begin(); w != waiters.end(); ++w) {
+        if (w->process == process) {
+            endInversion(*w);
+            waiters.erase(w);
+            break;
+        }
+    }
+    waitGraph.removeWaiter(lock.graphId, process);
+    // 排在前面的写者离开后，后面的读者可能可以获得了
+    grantLockWaiters(name);
+    updateHeldInversions(process);
+}
+
+void ResourceManager::insertLockWaiter(KernelLock& lock, const LockWaiter& waiter) {
+    auto pos = upper_bound(lock.waiters.begin(), lock.waiters.end(), waiter,
+                           [](const LockWaiter& a, const LockWaiter& b) {
+                               if (a.process->get_priority() != b.process->get_priority()) {
+                                   return a.process->get_priority() > b.process->get_priority();
+                               }
+                               return a.ticket < b.ticket;
+                           });
+    lock.waiters.insert(pos, waiter);
+}
+
+int ResourceManager::getBasePriority(Process* process) const {
+    auto it = basePriority.find(process->get_pid());
+    return it == basePriority.end() ? process->get_priority() : it->second;
+}
+
+int ResourceManager::inheritedPriority(Process* process) const {
+    int priority = getBasePriority(process);
+    auto held = heldLocks.find(process->get_pid());
+    if (!inheritanceEnabled || held == heldLocks.end()) {
+        return priority;
+    }
+    // 等待者按有效优先级排队，每把锁只需看排在最前的
+    for (const string& name : held->second) {
+        const KernelLock& lock = locks.at(name);
+        if (!lock.waiters.empty()) {
+            priority = max(priority, lock.waiters.front().process->get_priority());
+        }
+    }
+    return priority;
+}
+
+bool ResourceManager::updatePriority(Process* process) {
+    string pid = process->get_pid();
+    int base = getBasePriority(process);
+    int current = process->get_priority();
+    int target = inheritedPriority(process);
+    if (target == current) {
+        return false;
+    }
+    if (target == base) {
+        basePriority.erase(pid);
+    } else {
+        basePriority[pid] = base;
+    }
+    if (target > current) {
+        boosts++;
+    }
+    process->set_priority(target);
+    cout << "ResourceManager: 进程 " << pid << " 优先级 " << current << " -> " << target
+         << (target == base ? " (恢复)" : " (继承)") << endl;
+
+    // 排队的位置随优先级变化：在锁上总是按优先级，在资源上只有按优先级唤醒时
+    auto waiting = lockWaits.find(pid);
+    if (waiting != lockWaits.end()) {
+        KernelLock& lock = locks[waiting->second];
+        auto w = find_if(lock.waiters.begin(), lock.waiters.end(),
+                         [process](const LockWaiter& entry) { return entry.process == process; });
+        LockWaiter entry = *w;
+        lock.waiters.erase(w);
+        insertLockWaiter(lock, entry);
+    }
+    auto queued = queuedOn.find(pid);
+    if (queued != queuedOn.end() && wakeupOrder == WAKE_PRIORITY) {
+        deque<Waiter>& queue = queued->second == -1 ? retryWaiters : waitQueues[queued->second];
+        auto w = find_if(queue.begin(), queue.end(), [process](const Waiter& entry) { return entry.process == process; });
+        if (w != queue.end()) {
+            Waiter entry = *w;
+            queue.erase(w);
+            insertWaiter(queue, entry);
+        }
+    }
+    return true;
+}
+
+void ResourceManager::propagatePriority(const string& name) {
+    // 沿 锁 -> 持有者 -> 持有者等待的锁 传递，某个持有者的优先级不变时这条链到此为止；
+    // 没有死锁时链长不超过锁的个数，超过说明成环（交给死锁检测），不再传递
+    vector<pair<string, int>> pending(1, make_pair(name, 1));
+    while (!pending.empty()) {
+        string current = pending.back().first;
+        int depth = pending.back().second;
+        pending.pop_back();
+        if (depth > (int)locks.size()) {
+            continue;
+        }
+        for (Process* holder : lockHolders(locks[current])) {
+            if (!updatePriority(holder)) {
+                continue;
+            }
+            longestBoostChain = max(longestBoostChain, depth);
+            auto waiting = lockWaits.find(holder->get_pid());
+            if (waiting != lockWaits.end()) {
+                pending.push_back(make_pair(waiting->second, depth + 1));
+            }
+        }
+    }
+}
+
+bool ResourceManager::blockedByLower(Process* process, const string& name) const {
+    int priority = getBasePriority(process);
+    vector<pair<string, int>> pending(1, make_pair(name, 1));
+    while (!pending.empty()) {
+        string current = pending.back().first;
+        int depth = pending.back().second;
+        pending.pop_back();
+        if (depth > (int)locks.size()) {
+            continue;
+        }
+        for (Process* holder : lockHolders(locks.at(current))) {
+            if (getBasePriority(holder) < priority) {
+                return true;
+            }
+            auto waiting = lockWaits.find(holder->get_pid());
+            if (waiting != lockWaits.end()) {
+                pending.push_back(make_pair(waiting->second, depth + 1));
+            }
+        }
+    }
+    return false;
+}
+
+void ResourceManager::updateInversions(const string& name) {
+    // 一把锁的持有或等待关系变化，只影响链上经过它的等待者：它自己的等待者，
+    // 以及沿 等待者持有的锁 -> 那把锁的等待者 反向上溯到的各级等待者
+    set<string> visited;
+    vector<string> pending(1, name);
+    while (!pending.empty()) {
+        string current = pending.back();
+        pending.pop_back();
+        if (!visited.insert(current).second) {
+            continue;
+        }
+        for (LockWaiter& waiter : locks[current].waiters) {
+            bool inverted = blockedByLower(waiter.process, current);
+            if (inverted && waiter.invertedSince < 0) {
+                waiter.invertedSince = clock;
+            } else if (!inverted) {
+                endInversion(waiter);
+            }
+            auto held = heldLocks.find(waiter.process->get_pid());
+            if (held != heldLocks.end()) {
+                pending.insert(pending.end(), held->second.begin(), held->second.end());
+            }
+        }
+    }
+}
+
+void ResourceManager::updateHeldInversions(Process* process) {
+    // 进程开始或停止等待时，在它持有的锁上等待的进程的链随之变化
+    auto held = heldLocks.find(process->get_pid());
+    if (held == heldLocks.end()) {
+        return;
+    }
+    for (const string& name : held->second) {
+        updateInversions(name);
+    }
+}
+
+void ResourceManager::endInversion(LockWaiter& waiter) {
+    if (waiter.invertedSince < 0) {
+        return;
+    }
+    int duration = clock - waiter.invertedSince;
+    inversions++;
+    totalInversionTime += duration;
+    longestInversion = max(longestInversion, duration);
+    waiter.invertedSince = -1;
+}
+
+void ResourceManager::setPriorityInheritance(bool enabled) {
+    inheritanceEnabled = enabled;
+    for (auto& pair : locks) {
+        propagatePriority(pair.first);
+    }
+    // 反转按基础优先级判断，与是否继承无关，不用重新计算
+}
+
+void ResourceManager::setTime(int now) {
+    clock = now;
+}
+
+void ResourceManager::showLockStatus() {
+    if (locks.empty()) {
+        return;
+    }
+    cout << "内核锁: 优先级继承 " << (inheritanceEnabled ? "开启" : "关闭") << ", 提升优先级 " << boosts
+         << " 次, 最长继承链 " << longestBoostChain << ", 优先级反转 " << inversions << " 次 (累计 "
+         << totalInversionTime << ", 最长 " << longestInversion << ")" << endl;
+    for (auto& pair : locks) {
+        const KernelLock& lock = pair.second;
+        cout << "  " << pair.first << (lock.readWrite ? " [读写锁]" : " [互斥锁]") << " 获得 " << lock.acquisitions
+             << " 次, 等待 " << lock.contentions << " 次; 持有:";
+        for (Process* holder : lockHolders(lock)) {
+            cout << " " << holder->get_pid();
+            if (lock.readWrite) {
+                cout << (holder == lock.writer ? "(写)" : "(读)");
+            }
+            if (getBasePriority(holder) != holder->get_priority()) {
+                cout << "[" << getBasePriority(holder) << "->" << holder->get_priority() << "]";
+            }
+        }
+        if (!lock.waiters.empty()) {
+            cout << "; 等待:";
+            for (const LockWaiter& waiter : lock.waiters) {
+                cout << " " << waiter.process->get_pid();
+                if (lock.readWrite) {
+                    cout << (waiter.exclusive ? "(写)" : "(读)");
+                }
+                if (waiter.invertedSince >= 0) {
+                    cout << "*";  // 正处于优先级反转
+                }
+            }
+        }
+        cout << endl;
+    }
+}
+
+bool ResourceManager::setAvoidance(bool enabled) {
+    for (const ResourceVector& held : processResources) {
+        if (none_of(held.begin(), held.end(), [](int amount) { return amount > 0; })) {
+            continue;
+        }
+        cout << "ResourceManager: 仍有进程持有资源，不能切换死锁避免模式" << endl;
+        return false;
+    }
+    avoidanceEnabled = enabled;
+    claims.clear();
+    freeClaims.clear();
+    claimSlots.clear();
+    safeSequence.clear();
+    return true;
+}
+
+bool ResourceManager::toVector(const map<string, int>& amounts, ResourceVector& result) {
+    result.fill(0);
+    for (auto& pair : amounts) {
+        auto it = resourceIndex.find(pair.first);
+        if (it == resourceIndex.end() || pair.second < 0) {
+            return false;
+        }
+        result[it->second] = pair.second;
+    }
+    return true;
+}
+
+bool ResourceManager::declareMaxClaim(const string& pid, const map<string, int>& maximum) {
+    ResourceVector claim;
+    return toVector(maximum, claim) && declareMaxClaim(pid, claim);
+}
+
+bool ResourceManager::declareMaxClaim(const string& pid, const ResourceVector& claim) {
+    if (!avoidanceEnabled) {
+        return false;
+    }
+    for (int j = 0; j < resourceCount; j++) {
+        if (claim[j] > total[j]) {
+            cout << "ResourceManager: 进程 " << pid << " 对 " << resourceNames[j]
+                 << " 的最大需求超过总量" << endl;
+            return false;
+        }
+    }
+
+    int index = pidIndex(pid);
+    if (index == -1) {
+        cout << "ResourceManager: 进程号 " << pid << " 无效" << endl;
+        return false;
+    }
+    int existingSlot = claimOf(index);
+    if (existingSlot != -1) {
+        // 持有资源后再改最大需求可能使状态不安全，只允许在分配之前修改
+        Claim& existing = claims[existingSlot];
+        for (int amount : existing.allocated) {
+            if (amount > 0) return false;
+        }
+        existing.maximum = claim;
+        safeSequence.erase(find(safeSequence.begin(), safeSequence.end(), existingSlot));
+        safeSequence.push_back(existingSlot);
+        return true;
+    }
+
+    int slot;
+    if (!freeClaims.empty()) {
+        slot = freeClaims.back();
+        freeClaims.pop_back();
+    } else {
+        slot = (int)claims.size();
+        claims.push_back(Claim());
+    }
+    claims[slot].pid = pid;
+    claims[slot].maximum = claim;
+    claims[slot].allocated.fill(0);
+    if (index >= (int)claimSlots.size()) {
+        claimSlots.resize(index + 1, -1);
+    }
+    claimSlots[index] = slot;
+
+    // 尚未持有资源、最大需求不超过总量的进程排在安全序列末尾总能完成，原序列仍然安全
+    safeSequence.push_back(slot);
+    return true;
+}
+
+void ResourceManager::retireClaim(int index) {
+    int slot = claimOf(index);
+    if (slot == -1) {
+        return;
+    }
+    // 去掉一个进程不会使其余进程的完成顺序失效
+    safeSequence.erase(find(safeSequence.begin(), safeSequence.end(), slot));
+    claims[slot].pid.clear();
+    freeClaims.push_back(slot);
+    claimSlots[index] = -1;
+}
+
+bool ResourceManager::verifySequence(ResourceVector work) {
+    for (int slot : safeSequence) {
+        const Claim& claim = claims[slot];
+        int over = 0;
+        for (int j = 0; j < MAX_RESOURCES; j++) {
+            over |= claim.maximum[j] - claim.allocated[j] > work[j];
+        }
+        if (over) {
+            return false;
+        }
+        for (int j = 0; j < MAX_RESOURCES; j++) {
+            work[j] += claim.allocated[j];
+        }
+    }
+    return true;
+}
+
+bool ResourceManager::buildSafeSequence(ResourceVector work, vector<int>& sequence) {
+    // 每类资源把进程按剩余需求升序排列，work 增长时各指针前移；
+    // 一个进程在所有资源上都被越过即可完成，归还资源后继续推进，总计 O(n·m·log n)
+    size_t m = resourceCount;
+    vector<int> slots;
+    for (int slot = 0; slot < (int)claims.size(); slot++) {
+        if (!claims[slot].pid.empty()) {
+            slots.push_back(slot);
+        }
+    }
+    vector<vector<int>> order(m, slots);
+    for (size_t j = 0; j < m; j++) {
+        sort(order[j].begin(), order[j].end(), [this, j](int a, int b) {
+            return claims[a].maximum[j] - claims[a].allocated[j] < claims[b].maximum[j] - claims[b].allocated[j];
+        });
+    }
+
+    vector<size_t> cursor(m, 0);
+    vector<int> satisfied(claims.size(), 0);
+    vector<int> finishable;
+    auto advance = [&](size_t j) {
+        while (cursor[j] < order[j].size()) {
+            int slot = order[j][cursor[j]];
+            if (claims[slot].maximum[j] - claims[slot].allocated[j] > work[j]) break;
+            cursor[j]++;
+            if (++satisfied[slot] == (int)m) finishable.push_back(slot);
+        }
+    };
+    for (size_t j = 0; j < m; j++) {
+        advance(j);
+    }
+
+    sequence.clear();
+    while (!finishable.empty()) {
+        int slot = finishable.back();
+        finishable.pop_back();
+        sequence.push_back(slot);
+        for (size_t j = 0; j < m; j++) {
+            if (claims[slot].allocated[j] > 0) {
+                work[j] += claims[slot].allocated[j];
+                advance(j);
+            }
+        }
+    }
+    return sequence.size() == slots.size();
+}
+
+bool ResourceManager::isSafeGrant(int slot, const ResourceVector& request) {
+    Claim& claim = claims[slot];
+    for (int j = 0; j < resourceCount; j++) {
+        if (claim.allocated[j] + request[j] > claim.maximum[j]) {
+            cout << "ResourceManager: 进程 " << claim.pid << " 请求的 " << resourceNames[j]
+                 << " 超过其声明的最大需求" << endl;
+            return false;
+        }
+    }
+
+    // 假设分配后检查：先沿用上次的安全序列，失效时重新求解；求出的序列对应分配后的状态，随分配一起生效
+    safetyChecks++;
+    ResourceVector work = available;
+    for (int j = 0; j < MAX_RESOURCES; j++) {
+        work[j] -= request[j];
+        claim.allocated[j] += request[j];
+    }
+    bool safe = true;
+    if (verifySequence(work)) {
+        sequenceHits++;
+    } else {
+        vector<int> sequence;
+        safe = buildSafeSequence(work, sequence);
+        if (safe) {
+            safeSequence.swap(sequence);
+            sequenceRebuilds++;
+        }
+    }
+    for (int j = 0; j < MAX_RESOURCES; j++) {
+        claim.allocated[j] -= request[j];
+    }
+
+    if (!safe) {
+        unsafeDenials++;
+        cout << "ResourceManager: 拒绝进程 " << claim.pid << " 的请求，分配后将处于不安全状态" << endl;
+    }
+    return safe;
+}
+
+void ResourceManager::showAvoidanceStatus() {
+    cout << "死锁避免: " << (avoidanceEnabled ? "开启" : "关闭") << ", 已声明进程 " << claims.size() - freeClaims.size()
+         << ", 安全性检查 " << safetyChecks << " 次 (沿用安全序列 " << sequenceHits << " 次, 重新求解 "
+         << sequenceRebuilds << " 次), 拒绝不安全请求 " << unsafeDenials << " 次" << endl;
+    if (avoidanceEnabled && !safeSequence.empty() && safeSequence.size() <= 16) {
+        cout << "安全序列:";
+        for (int slot : safeSequence) {
+            cout << " " << claims[slot].pid;
         }
+        cout << endl;
+    }
+}
+
+bool ResourceManager::allocateResource(Process* process, const string& resourceName, int amount) {
+    int id = getResourceId(resourceName);
+    return id != -1 && allocateResource(process, id, amount);
+}
+
+bool ResourceManager::allocateResource(Process* process, int id, int amount) {
+    if (available[id] >= amount) {
+        available[id] -= amount;
+        waitGraph.setAvailable(graphIds[id], available[id]);
+        cout << "Allocated " << amount << " " << resourceNames[id]
+             << " to process " << process->get_pid() << endl;
+        return true;
     }
     return false;
 }
 
 void ResourceManager::freeResource(Process* process, const string& resourceName, int amount) {
-    if (resources.find(resourceName) != resources.end()) {
-        resources[resourceName]->available += amount;
-        cout << "Released " << amount << " " << resourceName 
-             << " from process " << process->get_pid() << endl;
+    int id = getResourceId(resourceName);
+    if (id != -1) {
+        freeResource(process, id, amount);
     }
 }
 
+void ResourceManager::freeResource(Process* process, int id, int amount) {
+    available[id] += amount;
+    waitGraph.setAvailable(graphIds[id], available[id]);
+    cout << "Released " << amount << " " << resourceNames[id]
+         << " from process " << process->get_pid() << endl;
+    wakeWaiters(id);
+}
+
 void ResourceManager::showResourceStatus() {
     cout << "\n=== Resource Status ===" << endl;
-    for (auto& pair : resources) {
-        Resource* res = pair.second;
-        cout << res->name << ": " << res->available << "/" << res->total 
-             << " (Used: " << (res->total - res->available) << ")" << endl;
+    for (int j = 0; j < resourceCount; j++) {
+        cout << resourceNames[j] << ": " << available[j] << "/" << total[j]
+             << " (Used: " << (total[j] - available[j]) << ")" << endl;
     }
     cout << "======================" << endl;
-}
\ No newline at end of file
+}
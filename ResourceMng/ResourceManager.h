@@ -4,35 +4,213 @@
 #include "Process/Process.h"
 #include <map>
 #include "Page/PageMng.h"
+#include "ResourceMng/WaitForGraph.h"
 #include <string>
 #include <vector>
+#include <array>
+#include <deque>
+#include <set>
+
+class Semaphore;
+
+// 资源等待队列内的唤醒顺序
+enum WakeupOrder {
+    WAKE_FIFO = 0,       // 按开始等待的先后
+    WAKE_PRIORITY = 1    // 优先级高者先（同优先级按先后）
+};
 
 class ResourceManager {
+public:
+    // 资源名在启动时登记为从 0 开始的编号，总量、可用量、需求与占用都是按编号存放的定长数组，
+    // 未登记的位置为 0；可行性检查是两个数组逐项比较，调度时不再查字符串
+    static const int MAX_RESOURCES = 8;
+    typedef std::array<int, MAX_RESOURCES> ResourceVector;
+
 private:
-    struct Resource {
-        int total;
-        int available;
-        string name;
-        
-        Resource(int t, string n) : total(t), available(t), name(n) {}
+    // 资源等待队列中的进程：需求在阻塞时算好，ticket 为第一次阻塞的先后，重新排队时不变
+    struct Waiter {
+        Process* process;
+        ResourceVector demand;
+        long long ticket;
     };
-    
-    map<string, Resource*> resources;
-    map<string, vector<string>> processResources; // 进程占用的资源
+
+    // 银行家算法中一个进程的最大需求与已分配量
+    struct Claim {
+        string pid;
+        ResourceVector maximum;
+        ResourceVector allocated;
+    };
+
+    int resourceCount;
+    ResourceVector total;
+    ResourceVector available;
+    vector<string> resourceNames;       // 资源编号 -> 名称
+    map<string, int> resourceIndex;     // 名称 -> 资源编号
+    array<int, MAX_RESOURCES> graphIds; // 资源编号 -> 等待图中的编号
+    int cpuId, diskId, printerId;       // 调度时按属性拼需求用到的资源
+    // 按进程的表以进程号（十进制数字，与分页管理器相同的上限）为下标，调度时不查字符串
+    vector<ResourceVector> processResources; // 进程号 -> 占用的各资源数量
     PagingMemoryManager* pagingManager; // 分页内存管理器
 
+    // 死锁避免（银行家算法）：安全性检查先验证上次求得的安全序列，只有它失效时才重新求解
+    bool avoidanceEnabled;
+    vector<Claim> claims;               // 声明了最大需求的进程，空出的位置留给之后的进程
+    vector<int> freeClaims;             // claims 中空闲的位置
+    vector<int> claimSlots;             // 进程号 -> claims 中的位置，-1 为未声明
+    vector<int> safeSequence;           // 上次求得的安全序列（claims 中的位置），覆盖所有已声明的进程
+    long long safetyChecks;
+    long long sequenceHits;             // 缓存的安全序列仍然有效的次数
+    long long sequenceRebuilds;         // 重新求解安全序列的次数
+    long long unsafeDenials;            // 因会导致不安全状态而拒绝的请求数
+
+    // 等待队列：被调度器阻塞的进程排在它缺的第一个资源的队列上，只有该资源被归还时才检查它；
+    // 需求全部能满足的进程被唤醒，等调度器放回就绪队列，仍缺别的资源的转到那个资源的队列
+    array<deque<Waiter>, MAX_RESOURCES> waitQueues;
+    deque<Waiter> retryWaiters;         // 资源都够仍被拒绝（不安全或内存提交失败）的进程，任何归还后都唤醒重试
+    map<string, int> queuedOn;          // 进程 -> 所在队列的资源编号，-1 为 retryWaiters
+    map<string, long long> waitTickets; // 进程 -> 第一次阻塞时的 ticket，获得资源后清除
+    vector<Process*> wokenProcesses;
+    map<string, ResourceVector> promises; // 已唤醒、尚未重新申请的进程的需求，唤醒其他进程时视为已占用
+    ResourceVector promised;              // promises 之和
+    WakeupOrder wakeupOrder;
+    long long nextTicket;
+    long long wakeups;                  // 唤醒次数
+    long long requeues;                 // 转到其他资源队列的次数
+
+    // 死锁检测：资源与带等待图的信号量共用一张等待图，阻塞、获得、释放时增量更新，成环时回滚一个进程
+    WaitForGraph waitGraph;
+    long long rollbacks;
+
+    // 模拟的内核锁中等待的进程，按有效优先级排队
+    struct LockWaiter {
+        Process* process;
+        bool exclusive;         // 互斥锁或写锁
+        long long ticket;
+        int since;              // 开始等待的时刻
+        int invertedSince;      // 被低优先级进程阻塞的开始时刻，-1 为当前没有
+    };
+
+    // 互斥锁与读写锁：锁空出时交给排在最前的等待者（读写锁连续交给排在前面的读者）；
+    // 有写者等待时新来的读者也排队，避免写者饿死
+    struct KernelLock {
+        bool readWrite;
+        Process* writer;                // 互斥锁的持有者也记在这里
+        vector<Process*> readers;
+        vector<LockWaiter> waiters;     // 有效优先级从高到低，同优先级按先后
+        long long acquisitions;
+        long long contentions;          // 需要等待的次数
+        int graphId;                    // 在等待图中的资源编号
+    };
+
+    // 读写锁在等待图中的单位数：读者占 1，写者占全部
+    static const int RWLOCK_UNITS = 1 << 16;
+
+    // 优先级继承：持有者的优先级临时提升到它所持有的锁上最高的等待者，持有者又在等别的锁时沿链继续传递；
+    // 优先级反转按模拟时间计：等待者的链上出现基础优先级比它低的持有者起，到链上不再有这样的进程为止
+    map<string, KernelLock> locks;
+    map<string, set<string>> heldLocks; // 进程 -> 持有的锁
+    map<string, string> lockWaits;      // 进程 -> 等待的锁
+    map<string, int> basePriority;      // 被提升的进程 -> 原优先级
+    bool inheritanceEnabled;
+    int clock;                          // 模拟时间，由调度器更新
+    long long boosts;                   // 提升优先级的次数
+    int longestBoostChain;              // 提升沿锁传递的最长链（直接持有者为 1）
+    long long inversions;               // 已结束的优先级反转次数
+    long long totalInversionTime;
+    int longestInversion;
+
+    // 逐项比较 need <= have，不提前退出，便于编译器向量化
+    static bool fits(const ResourceVector& need, const ResourceVector& have);
+    static int pidIndex(const string& pid);  // 进程号无效时返回 -1
+    ResourceVector& heldBy(int index);
+    int claimOf(int index) const;            // 未声明时返回 -1
+    int registerResource(const string& name, int amount);
+    bool toVector(const map<string, int>& amounts, ResourceVector& result);
+    ResourceVector demandOf(Process* process);
+    bool declareMaxClaim(const string& pid, const ResourceVector& maximum);
+    bool verifySequence(ResourceVector work);
+    bool buildSafeSequence(ResourceVector work, vector<int>& sequence);
+    bool isSafeGrant(int slot, const ResourceVector& request);
+    bool canGrant(const string& pid, int index, const ResourceVector& request);
+    void applyGrant(Process* process, int index, const ResourceVector& request);
+    bool allocateResource(Process* process, int id, int amount);
+    void freeResource(Process* process, int id, int amount);
+    void retireClaim(int index);
+    void recordWaits(Process* process, const ResourceVector& request);
+    int firstLacking(const ResourceVector& demand, const ResourceVector& have) const;
+    bool waitsBefore(const Waiter& a, const Waiter& b) const;
+    void insertWaiter(deque<Waiter>& queue, const Waiter& waiter);
+    void enqueueWaiter(Process* process, const ResourceVector& demand, int id);
+    void cancelWaiter(Process* process);
+    void dropPromise(const string& pid);
+    void wakeWaiters(int id);
+    void releaseHoldings(Process* process);
+    Process* chooseVictim(const vector<Process*>& deadlocked);
+    void resolveDeadlock(const vector<Process*>& deadlocked);
+    bool createLock(const string& name, bool readWrite);
+    bool acquireLock(Process* process, const string& name, bool exclusive);
+    void grantLock(const string& name, Process* process, bool exclusive);
+    void grantLockWaiters(const string& name);
+    void cancelLockWait(Process* process);
+    vector<Process*> lockHolders(const KernelLock& lock) const;
+    int lockUnits(const KernelLock& lock, bool exclusive) const;
+    int freeLockUnits(const KernelLock& lock) const;
+    void insertLockWaiter(KernelLock& lock, const LockWaiter& waiter);
+    int inheritedPriority(Process* process) const;
+    bool updatePriority(Process* process);
+    void propagatePriority(const string& name);
+    bool blockedByLower(Process* process, const string& name) const;
+    void updateInversions(const string& name);
+    void updateHeldInversions(Process* process);
+    void endInversion(LockWaiter& waiter);
+
 public:
     ResourceManager(PagingMemoryManager* pm);
     ~ResourceManager();
     
     void initializeResources();
+    // 调度器为进程申请运行所需资源；失败时进程进入等待队列，资源归还后按需唤醒
     bool requestResources(Process* process);
+    // 在已持有的资源之外再请求一批资源（资源名 -> 数量），全部满足才分配；失败时不排队，由调用者重试
+    bool requestResources(Process* process, const map<string, int>& request);
+    bool requestResources(Process* process, const ResourceVector& request);
+    int getResourceId(const string& name) const;  // 未登记的资源返回 -1
     void releaseResources(Process* process);
+
+    // 死锁避免：开启后每次分配前做安全性检查，会导致不安全状态的请求被拒绝（进程等待）；
+    // 进程应先声明各资源的最大需求，未声明时以其第一次请求作为最大需求。只能在没有进程持有资源时切换
+    bool setAvoidance(bool enabled);
+    bool declareMaxClaim(const string& pid, const map<string, int>& maximum);
+    void showAvoidanceStatus();
+
+    // 创建参与死锁检测的信号量（按互斥锁使用：P 获得，V(process) 归还），已存在同名信号量时返回空
+    Semaphore* createSemaphore(const string& name, int value);
+    // 回滚进程：撤销它的所有等待并归还它持有的资源与信号量，进程之后从头重新申请；内存不受影响
+    void rollbackProcess(Process* process);
+    void showDeadlockStatus();
+
+    // 模拟的内核锁，与资源、信号量同名时创建失败。获得锁返回 true；否则进程阻塞在锁上（状态置为 blocked），
+    // 锁交给它时置为 ready。锁参与死锁检测，进程终止或被回滚时归还持有的锁
+    bool createMutex(const string& name);
+    bool createRWLock(const string& name);
+    bool lockMutex(Process* process, const string& name);
+    bool readLock(Process* process, const string& name);
+    bool writeLock(Process* process, const string& name);
+    void unlock(Process* process, const string& name);  // 归还进程在该锁上的持有（互斥、读或写）
+    // 关闭时只按优先级排队、不提升持有者，用于对比优先级反转的时长
+    void setPriorityInheritance(bool enabled);
+    int getBasePriority(Process* process) const;        // 未被提升时即当前优先级
+    void setTime(int now);
+    void showLockStatus();
     
     bool allocateResource(Process* process, const string& resourceName, int amount = 1);
     void freeResource(Process* process, const string& resourceName, int amount = 1);
-    bool handleMemoryShortage(Process* process);
+    // 将进程按调度需求排到指定资源的等待队列（同名信号量存在时在信号量上等待）
     void addToWaitingQueue(Process* process, const string& resourceName);
+    // 取走自上次调用以来被唤醒的进程，由调度器从阻塞队列移回就绪队列
+    vector<Process*> takeWokenProcesses();
+    void setWakeupOrder(WakeupOrder order);
+    void showWaitQueues();
     void showResourceStatus();
 };
 
@@ -1,57 +1,207 @@
 #include "Semaphore.h"
 #include "Process/Process.h"
+#include "WaitForGraph.h"
 #include <iostream>
+#include <algorithm>
 
-Semaphore::Semaphore(int initial_value, std::string sem_name) 
-    : value(initial_value), name(sem_name) {}
+Semaphore::Semaphore(int initial_value, std::string sem_name, WaitForGraph* graph)
+    : value(initial_value), name(sem_name), waitGraph(graph), graphId(-1), fastAcquires(0), fastReleases(0),
+      lockedAcquires(0), contentions(0), handoffs(0), cancellations(0), totalWaitNs(0), maxWaitNs(0) {
+    if (waitGraph) {
+        graphId = waitGraph->resourceId(name);
+        waitGraph->setAvailable(graphId, initial_value);
+    }
+}
 
 bool Semaphore::P(Process* process) {
-    value--;
-    if (value < 0) {
-        // 资源不足，进程进入等待队列
-        waitingQueue.push(process);
-        process->set_state("blocked");
-        std::cout << "Process " << process->get_pid() 
+    return enter(process, nullptr);
+}
+
+bool Semaphore::acquire(Process* process) {
+    Handoff handoff = HANDOFF_WAITING;
+    if (enter(process, &handoff)) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    handoffReady.wait(lock, [&handoff] { return handoff != HANDOFF_WAITING; });
+    return handoff == HANDOFF_GRANTED;
+}
+
+bool Semaphore::enter(Process* process, Handoff* handoff) {
+    if (!waitGraph) {
+        // 快速路径：还有剩余时一次 CAS 拿走
+        int current = value.load(std::memory_order_relaxed);
+        while (current > 0) {
+            if (value.compare_exchange_weak(current, current - 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+                fastAcquires.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    int remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        remaining = value.fetch_sub(1, std::memory_order_acquire) - 1;
+        if (remaining >= 0) {
+            lockedAcquires++;  // 加锁前有人归还了
+        } else {
+            // 资源不足，进程进入等待队列；入队前置为阻塞，否则可能覆盖掉随后 V 设置的就绪
+            process->set_state("blocked");
+            waitingQueue.push_back(Waiter{process, std::chrono::steady_clock::now(), handoff});
+            contentions++;
+        }
+    }
+
+    if (remaining < 0) {
+        std::cout << "Process " << process->get_pid()
                   << " blocked waiting for " << name << std::endl;
+        if (waitGraph) {
+            waitGraph->addWaiter(graphId, process);
+        }
         return false;
     }
+    if (waitGraph) {
+        waitGraph->setAvailable(graphId, remaining);
+        waitGraph->addHolder(graphId, process);
+    }
     return true;
 }
 
 void Semaphore::V() {
-    value++;
-    if (value <= 0 && !waitingQueue.empty()) {
-        // 有等待的进程，唤醒一个
-        Process* process = waitingQueue.front();
-        waitingQueue.pop();
-        process->set_state("ready");
-        std::cout << "Process " << process->get_pid() 
-                  << " waken up for " << name << std::endl;
+    int previous = value.fetch_add(1, std::memory_order_release);
+    if (previous >= 0) {
+        // 没有等待者
+        fastReleases.fetch_add(1, std::memory_order_relaxed);
+        if (waitGraph) {
+            waitGraph->setAvailable(graphId, previous + 1);
+        }
+        return;
+    }
+
+    // 有等待的进程，唤醒一个；它可能刚被撤销，这时计数已由撤销方补回
+    Process* process = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!waitingQueue.empty()) {
+            Waiter waiter = waitingQueue.front();
+            waitingQueue.pop_front();
+            process = waiter.process;
+            long long waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - waiter.since).count();
+            handoffs++;
+            totalWaitNs += waited;
+            maxWaitNs = std::max(maxWaitNs, waited);
+            finishWait(waiter, HANDOFF_GRANTED);
+        }
+    }
+    if (!process) {
+        return;
+    }
+    std::cout << "Process " << process->get_pid()
+              << " waken up for " << name << std::endl;
+    if (waitGraph) {
+        // 被唤醒的进程由等待者变为持有者
+        waitGraph->removeWaiter(graphId, process);
+        waitGraph->addHolder(graphId, process);
+    }
+}
+
+void Semaphore::V(Process* process) {
+    if (waitGraph) {
+        waitGraph->removeHolder(graphId, process);
+    }
+    V();
+}
+
+bool Semaphore::cancelWait(Process* process) {
+    int remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(waitingQueue.begin(), waitingQueue.end(),
+                               [process](const Waiter& waiter) { return waiter.process == process; });
+        if (it == waitingQueue.end()) {
+            return false;
+        }
+        Waiter waiter = *it;
+        waitingQueue.erase(it);
+        remaining = value.fetch_add(1, std::memory_order_release) + 1;
+        cancellations++;
+        finishWait(waiter, HANDOFF_CANCELLED);
+    }
+    if (waitGraph) {
+        if (remaining > 0) {
+            waitGraph->setAvailable(graphId, remaining);
+        }
+        waitGraph->removeWaiter(graphId, process);
+    }
+    return true;
+}
+
+void Semaphore::finishWait(const Waiter& waiter, Handoff result) {
+    // 调用者持有 mutex：进程状态与等待结果都在锁内写，acquire 醒来后读到的一定是写好的值
+    if (result == HANDOFF_GRANTED) {
+        waiter.process->set_state("ready");
+    }
+    if (waiter.handoff) {
+        *waiter.handoff = result;
+        handoffReady.notify_all();
     }
 }
 
 int Semaphore::getValue() const {
-    return value;
+    return value.load(std::memory_order_relaxed);
 }
 
 bool Semaphore::hasWaitingProcesses() const {
+    std::lock_guard<std::mutex> lock(mutex);
     return !waitingQueue.empty();
 }
 
 Process* Semaphore::getNextWaitingProcess() {
-    if (!waitingQueue.empty()) {
-        Process* process = waitingQueue.front();
-        waitingQueue.pop();
-        return process;
+    Process* process = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!waitingQueue.empty()) {
+            Waiter waiter = waitingQueue.front();
+            waitingQueue.pop_front();
+            process = waiter.process;
+            if (waiter.handoff) {
+                // 出队的等待者没有拿到单位，acquire 返回 false
+                *waiter.handoff = HANDOFF_CANCELLED;
+                handoffReady.notify_all();
+            }
+        }
     }
-    return nullptr;
+    if (process && waitGraph) {
+        waitGraph->removeWaiter(graphId, process);
+    }
+    return process;
 }
 
 std::string Semaphore::getName() const {
     return name;
 }
 
+long long Semaphore::getContentionCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return contentions;
+}
+
+double Semaphore::getAverageWaitMicros() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return handoffs ? totalWaitNs / 1000.0 / handoffs : 0.0;
+}
+
 void Semaphore::showStatus() {
-    std::cout << "Semaphore " << name << ": value=" << value 
+    std::lock_guard<std::mutex> lock(mutex);
+    long long acquires = fastAcquires.load() + lockedAcquires + contentions;
+    std::cout << "Semaphore " << name << ": value=" << value.load()
               << ", waiting=" << waitingQueue.size() << std::endl;
-}
\ No newline at end of file
+    std::cout << "  P " << acquires << " 次 (无锁 " << fastAcquires.load() << ", 加锁 " << lockedAcquires
+              << ", 等待 " << contentions << "), V 无锁 " << fastReleases.load() << " 次, 交给等待者 "
+              << handoffs << " 次, 撤销等待 " << cancellations << " 次, 等待时间 平均 "
+              << (handoffs ? totalWaitNs / 1000.0 / handoffs : 0.0) << "us 最长 " << maxWaitNs / 1000.0
+              << "us" << std::endl;
+}
@@ -2,26 +2,70 @@
 #define SEMAPHORE_H
 
 #include <string>
-#include <queue>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
+class Process;
+class WaitForGraph;
+
+// 可在多线程中使用的信号量：计数为原子变量，非负时为剩余数量，为负时其绝对值为等待的进程数
+// 无竞争时 P 是一次 CAS、V 是一次原子加，不加锁；只有要等待或要唤醒等待者时才进入互斥锁保护的等待队列。
+// 进程在加锁状态下扣减计数并入队，因此 V 看到负的计数后拿到锁时等待者一定已在队列中（除非已被撤销）。
+// 多线程中用 acquire 阻塞等待：V 在锁内把单位交给等待者并经条件变量通知，不经进程状态传递；
+// P 立即返回，供单线程的模拟调度器使用，被唤醒的进程由调度器按进程状态恢复运行
 class Semaphore {
 private:
-    int value;
-    std::queue<Process*> waitingQueue;
+    enum Handoff { HANDOFF_WAITING, HANDOFF_GRANTED, HANDOFF_CANCELLED };
+
+    struct Waiter {
+        Process* process;
+        std::chrono::steady_clock::time_point since;
+        Handoff* handoff;   // acquire 的等待结果，由 mutex 保护；P 入队的为空
+    };
+
+    std::atomic<int> value;
+    std::deque<Waiter> waitingQueue;    // 由 mutex 保护
+    mutable std::mutex mutex;
+    std::condition_variable handoffReady;   // 等待者的结果变化时通知 acquire
     std::string name;
+    // 非空时按锁的方式使用：P 成功的进程成为持有者，V(process) 归还，持有与等待都登记到等待图参与死锁检测。
+    // 等待图本身不加锁，这类信号量只用于单线程模拟，且始终走加锁路径；回调可能重入信号量，都在解锁后调用
+    WaitForGraph* waitGraph;
+    int graphId;                            // 在等待图中的资源编号
+
+    std::atomic<long long> fastAcquires;    // 无锁获得
+    std::atomic<long long> fastReleases;    // 无等待者、无锁归还
+    long long lockedAcquires;               // 进入加锁路径但无需等待
+    long long contentions;                  // 需要等待的次数
+    long long handoffs;                     // 归还时直接交给等待者的次数
+    long long cancellations;
+    long long totalWaitNs;                  // 被唤醒者的等待时间之和（真实时间）
+    long long maxWaitNs;
 
 public:
-    Semaphore(int initial_value, std::string sem_name);
-    
-    bool P(Process* process);  // wait操作
-    void V();                  // signal操作
-    
+    Semaphore(int initial_value, std::string sem_name, WaitForGraph* graph = nullptr);
+
+    bool P(Process* process);  // wait操作：不阻塞，需要等待时返回 false
+    bool acquire(Process* process);  // 阻塞直到获得（true）或等待被撤销（false）
+    void V();                  // signal操作，不改变持有关系（用于同步而非互斥）
+    void V(Process* process);  // 持有者归还一个单位
+    bool cancelWait(Process* process);  // 撤销进程的等待（死锁回滚时用）
+
     int getValue() const;
     bool hasWaitingProcesses() const;
     Process* getNextWaitingProcess();
     std::string getName() const;
-    
+    long long getContentionCount() const;
+    double getAverageWaitMicros() const;
+
     void showStatus();
+
+private:
+    bool enter(Process* process, Handoff* handoff);
+    void finishWait(const Waiter& waiter, Handoff result);
 };
 
-#endif
\ No newline at end of file
+#endif
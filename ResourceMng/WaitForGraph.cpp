@@ -0,0 +1,290 @@
+#include "WaitForGraph.h"
+#include <iostream>
+using namespace std;
+
+WaitForGraph::WaitForGraph() : handling(false), searches(0), deadlocks(0) {}
+
+void WaitForGraph::setDeadlockHandler(DeadlockHandler deadlockHandler) {
+    handler = deadlockHandler;
+}
+
+int WaitForGraph::resourceId(const string& name) {
+    auto it = resourceIds.find(name);
+    if (it != resourceIds.end()) {
+        return it->second;
+    }
+    int id = (int)resourceNames.size();
+    resourceNames.push_back(name);
+    resourceIds[name] = id;
+    holders.emplace_back();
+    waiters.emplace_back();
+    freeUnits.push_back(0);
+    return id;
+}
+
+const string& WaitForGraph::getResourceName(int resource) const {
+    return resourceNames[resource];
+}
+
+void WaitForGraph::addEdge(const string& from, const string& to) {
+    edges[from][to]++;
+}
+
+void WaitForGraph::removeEdge(const string& from, const string& to) {
+    auto out = edges.find(from);
+    if (out == edges.end()) return;
+    auto edge = out->second.find(to);
+    if (edge == out->second.end()) return;
+    if (--edge->second == 0) {
+        out->second.erase(edge);
+        if (out->second.empty()) edges.erase(out);
+    }
+}
+
+bool WaitForGraph::onCycle(const string& pid) {
+    searches++;
+    set<string> visited;
+    vector<string> stack(1, pid);
+    while (!stack.empty()) {
+        string node = stack.back();
+        stack.pop_back();
+        auto out = edges.find(node);
+        if (out == edges.end()) continue;
+        for (auto& edge : out->second) {
+            if (edge.first == pid) {
+                return true;
+            }
+            if (visited.insert(edge.first).second) {
+                stack.push_back(edge.first);
+            }
+        }
+    }
+    return false;
+}
+
+vector<string> WaitForGraph::deadlockedFrom(const string& pid) {
+    // 可达集合包含了其中等待者所等资源的全部持有者，归约只需在集合内进行
+    set<string> pending;
+    vector<string> stack(1, pid);
+    pending.insert(pid);
+    while (!stack.empty()) {
+        string node = stack.back();
+        stack.pop_back();
+        auto out = edges.find(node);
+        if (out == edges.end()) continue;
+        for (auto& edge : out->second) {
+            if (pending.insert(edge.first).second) {
+                stack.push_back(edge.first);
+            }
+        }
+    }
+
+    vector<int> work(freeUnits);
+    bool progress = true;
+    while (progress && pending.count(pid)) {
+        progress = false;
+        for (auto it = pending.begin(); it != pending.end();) {
+            bool finishable = true;
+            auto waiting = waits.find(*it);
+            if (waiting != waits.end()) {
+                for (auto& need : waiting->second) {
+                    if (need.second > work[need.first]) {
+                        finishable = false;
+                        break;
+                    }
+                }
+            }
+            if (!finishable) {
+                ++it;
+                continue;
+            }
+            auto owned = holdings.find(*it);
+            if (owned != holdings.end()) {
+                for (auto& pair : owned->second) {
+                    work[pair.first] += pair.second;
+                }
+            }
+            it = pending.erase(it);
+            progress = true;
+        }
+    }
+    if (!pending.count(pid)) {
+        return vector<string>();
+    }
+    return vector<string>(pending.begin(), pending.end());
+}
+
+void WaitForGraph::probe(const string& pid) {
+    pendingProbes.push_back(pid);
+    if (handling) {
+        return;  // 回滚会释放资源、唤醒等待者，可能再次进入这里
+    }
+
+    handling = true;
+    while (!pendingProbes.empty()) {
+        string origin = pendingProbes.front();
+        pendingProbes.pop_front();
+        vector<string> previous;
+        // 死锁可能涉及多个环，回滚一个进程后继续检测
+        while (onCycle(origin)) {
+            vector<string> stuck = deadlockedFrom(origin);
+            if (stuck.empty() || stuck == previous) {
+                break;  // 没有死锁，或回调没能打破它，不再重复报告
+            }
+            deadlocks++;
+            if (!handler) {
+                break;
+            }
+            vector<Process*> members;
+            for (const string& member : stuck) {
+                members.push_back(processes[member]);
+            }
+            handler(members);
+            previous = stuck;
+        }
+    }
+    handling = false;
+}
+
+void WaitForGraph::addWaiter(int resource, Process* process, int amount) {
+    string pid = process->get_pid();
+    processes[pid] = process;
+    map<int, int>& waiting = waits[pid];
+    auto it = waiting.find(resource);
+    if (it != waiting.end()) {
+        // 已在等待，边不变；需要的数量变多可能使原本能推进的进程陷入死锁
+        bool grew = amount > it->second;
+        it->second = amount;
+        if (grew) {
+            probe(pid);
+        }
+        return;
+    }
+    waiting[resource] = amount;
+    waiters[resource].insert(pid);
+    for (auto& holder : holders[resource]) {
+        if (holder.first != pid) {
+            addEdge(pid, holder.first);
+        }
+    }
+
+    probe(pid);
+}
+
+void WaitForGraph::removeWaiter(int resource, Process* process) {
+    string pid = process->get_pid();
+    auto waiting = waits.find(pid);
+    if (waiting == waits.end() || !waiting->second.erase(resource)) {
+        return;
+    }
+    if (waiting->second.empty()) {
+        waits.erase(waiting);
+    }
+    waiters[resource].erase(pid);
+    for (auto& holder : holders[resource]) {
+        if (holder.first != pid) {
+            removeEdge(pid, holder.first);
+        }
+    }
+}
+
+void WaitForGraph::clearWaits(Process* process) {
+    auto it = waits.find(process->get_pid());
+    while (it != waits.end()) {
+        // 删除最后一项时整个表项随之删除，每次重新查找
+        removeWaiter(it->second.begin()->first, process);
+        it = waits.find(process->get_pid());
+    }
+}
+
+void WaitForGraph::addHolder(int resource, Process* process, int amount) {
+    string pid = process->get_pid();
+    processes[pid] = process;
+    holdings[pid][resource] += amount;
+    int& held = holders[resource][pid];
+    held += amount;
+    if (held == amount) {
+        for (const string& waiter : waiters[resource]) {
+            if (waiter != pid) {
+                addEdge(waiter, pid);
+            }
+        }
+    }
+
+    // 拿走可用单位后，只有 pid 自己也在等待时才可能无法推进；不等待的进程总能完成并归还
+    if (waits.count(pid)) {
+        probe(pid);
+    }
+}
+
+void WaitForGraph::removeHolder(int resource, Process* process, int amount) {
+    string pid = process->get_pid();
+    auto holding = holders[resource].find(pid);
+    if (holding == holders[resource].end()) {
+        return;
+    }
+    int& held = holding->second;
+    int released = min(amount, held);
+    held -= released;
+    map<int, int>& owned = holdings[pid];
+    if ((owned[resource] -= released) <= 0) {
+        owned.erase(resource);
+        if (owned.empty()) holdings.erase(pid);
+    }
+    if (held > 0) {
+        return;
+    }
+
+    holders[resource].erase(holding);
+    for (const string& waiter : waiters[resource]) {
+        if (waiter != pid) {
+            removeEdge(waiter, pid);
+        }
+    }
+}
+
+void WaitForGraph::removeProcess(Process* process) {
+    string pid = process->get_pid();
+    clearWaits(process);
+    map<int, int> owned = getHoldings(pid);
+    for (auto& pair : owned) {
+        removeHolder(pair.first, process, pair.second);
+    }
+    processes.erase(pid);
+}
+
+void WaitForGraph::setAvailable(int resource, int units) {
+    freeUnits[resource] = units;
+}
+
+const map<int, int>& WaitForGraph::getWaits(const string& pid) const {
+    static const map<int, int> none;
+    auto it = waits.find(pid);
+    return it == waits.end() ? none : it->second;
+}
+
+const map<int, int>& WaitForGraph::getHoldings(const string& pid) const {
+    static const map<int, int> none;
+    auto it = holdings.find(pid);
+    return it == holdings.end() ? none : it->second;
+}
+
+long long WaitForGraph::getDeadlockCount() const {
+    return deadlocks;
+}
+
+void WaitForGraph::showStatus() const {
+    size_t edgeCount = 0;
+    for (auto& out : edges) {
+        edgeCount += out.second.size();
+    }
+    cout << "等待图: 等待中的进程 " << waits.size() << ", 边 " << edgeCount << ", 环检测 " << searches
+         << " 次, 发现死锁 " << deadlocks << " 次" << endl;
+    for (auto& out : edges) {
+        cout << "  " << out.first << " ->";
+        for (auto& edge : out.second) {
+            cout << " " << edge.first;
+        }
+        cout << endl;
+    }
+}
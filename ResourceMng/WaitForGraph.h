@@ -0,0 +1,83 @@
+#ifndef WAITFORGRAPH_H
+#define WAITFORGRAPH_H
+
+#include "Process/Process.h"
+#include <map>
+#include <set>
+#include <deque>
+#include <string>
+#include <vector>
+#include <functional>
+
+// 等待图：进程 P 等待的资源被进程 Q 持有时有边 P -> Q
+// 边随每次阻塞、获得、释放增量维护（同一对进程可因多个资源相连，按资源计数）；
+// 只有新增边才可能形成环，因此每次只从变化的边出发搜索，不做全图检测。
+// 资源有多个单位时环只是死锁的必要条件（环外的持有者归还后等待者仍可继续），
+// 发现环后再对该进程可达的子图做一次归约，确认确实无法推进才报告。
+// 资源名在第一次使用前登记为从 0 开始的编号，之后的增删都按编号，不再比较字符串
+class WaitForGraph {
+public:
+    // 检测到死锁时回调，参数为无法推进的进程
+    typedef std::function<void(const vector<Process*>&)> DeadlockHandler;
+
+private:
+    map<string, Process*> processes;
+    vector<string> resourceNames;            // 资源编号 -> 名称
+    map<string, int> resourceIds;            // 名称 -> 资源编号
+    vector<map<string, int>> holders;        // 资源 -> 持有者 -> 数量
+    vector<set<string>> waiters;             // 资源 -> 等待者
+    map<string, map<int, int>> holdings;     // 进程 -> 持有的资源 -> 数量
+    map<string, map<int, int>> waits;        // 进程 -> 等待的资源 -> 需要的数量
+    vector<int> freeUnits;                   // 资源 -> 当前可用的数量
+    map<string, map<string, int>> edges;     // 等待者 -> 持有者 -> 连接它们的资源数
+
+    DeadlockHandler handler;
+    deque<string> pendingProbes;             // 处理死锁期间又有新边的进程，处理完当前的再检测
+    bool handling;
+
+    long long searches;                      // 环检测次数
+    long long deadlocks;                     // 发现的死锁数
+
+    void addEdge(const string& from, const string& to);
+    void removeEdge(const string& from, const string& to);
+    // 是否存在经过 pid 的环
+    bool onCycle(const string& pid);
+    // 对 pid 可达的进程做归约：不等待的进程及需求能被满足的进程视为完成并归还所持资源，
+    // pid 无法完成时返回所有无法完成的进程，否则返回空
+    vector<string> deadlockedFrom(const string& pid);
+    // 新边都与 pid 相连时新环必经过 pid：反复检测并交给回调，直到 pid 不再处于死锁
+    void probe(const string& pid);
+
+public:
+    WaitForGraph();
+
+    void setDeadlockHandler(DeadlockHandler deadlockHandler);
+
+    // 资源名对应的编号，第一次出现时登记（可用量为 0）；以下接口中的 resource 都是这个编号
+    int resourceId(const string& name);
+    const string& getResourceName(int resource) const;
+
+    // 进程开始等待资源（或改变需要的数量）；新边可能使它落在环上，从它出发检测
+    void addWaiter(int resource, Process* process, int amount = 1);
+    void removeWaiter(int resource, Process* process);
+    void clearWaits(Process* process);
+
+    // 进程获得资源；它成为新持有者时，该资源的等待者都指向它；它自己也在等待时从它出发检测
+    void addHolder(int resource, Process* process, int amount = 1);
+    void removeHolder(int resource, Process* process, int amount = 1);
+
+    // 资源可用量变化时由资源的管理者更新
+    void setAvailable(int resource, int units);
+
+    // 撤销进程的全部等待与持有
+    void removeProcess(Process* process);
+
+    // 进程等待 / 持有的资源编号 -> 数量；返回的引用在下一次修改等待图前有效
+    const map<int, int>& getWaits(const string& pid) const;
+    const map<int, int>& getHoldings(const string& pid) const;
+
+    long long getDeadlockCount() const;
+    void showStatus() const;
+};
+
+#endif // WAITFORGRAPH_H
@@ -13,6 +13,7 @@ public:
     OSKernel() {
         // 初始化组件
         pagingManager = std::make_unique<PagingMemoryManager>(64, 4); // 64页框，4KB每页
+        pagingManager->enableSwap("", 4096);                          // 16MB 交换区
         resourceManager = std::make_unique<ResourceManager>(pagingManager.get());
         processManager = std::make_unique<ProcessManager>();
         
@@ -48,6 +49,20 @@ public:
         // 检查新到达的进程
         processManager->checkArrivingProcesses();
         
+        // 工作集超过物理内存时挂起进程，避免抖动
+        processManager->checkMemoryPressure();
+
+        // 空闲页框低于 low 水位时后台换出冷页，每次最多 16 页
+        pagingManager->reclaimPages(16);
+
+        // 每 DEDUP_SCAN_TICKS 个时钟中断扫描一批页框，合并内容相同的页
+        if (++timerTicks % DEDUP_SCAN_TICKS == 0) {
+            pagingManager->scanDuplicatePages(16);
+        }
+
+        // 有规整请求时每个时钟中断最多迁移 8 页
+        pagingManager->compactMemory(8);
+
         // 处理时间片轮转
         processManager->handleTimeSlice();
         
@@ -136,6 +151,8 @@ private:
     std::unique_ptr<ResourceManager> resourceManager;
     std::unique_ptr<ProcessManager> processManager;
     bool exit_flag = false;
+    int timerTicks = 0;
+    static const int DEDUP_SCAN_TICKS = 10;  // 合并扫描的间隔：页内容稳定一段时间后才值得合并
 };
 
 // 显示菜单的辅助函数